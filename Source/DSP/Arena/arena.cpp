@@ -0,0 +1,47 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "arena.h"
+
+#if JUCE_LINUX
+#include <sys/mman.h>
+#endif
+
+namespace zlarena {
+    Arena::~Arena() {
+        release();
+    }
+
+    void Arena::allocate() {
+        if (totalBytes > capacity) {
+            release();
+            const auto useHugePages = totalBytes >= hugePageSize;
+            dataAlignment = useHugePages ? hugePageSize : alignment;
+            capacity = roundUp(totalBytes, dataAlignment);
+            data = static_cast<std::byte *>(::operator new(capacity, std::align_val_t(dataAlignment)));
+#if JUCE_LINUX && defined(MADV_HUGEPAGE)
+            if (useHugePages) {
+                madvise(data, capacity, MADV_HUGEPAGE);
+            }
+#endif
+        }
+        if (data != nullptr) {
+            std::memset(data, 0, capacity);
+        }
+    }
+
+    void Arena::release() {
+        if (data != nullptr) {
+            ::operator delete(data, std::align_val_t(dataAlignment));
+            data = nullptr;
+            capacity = 0;
+        }
+    }
+} // zlarena
@@ -0,0 +1,84 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#ifndef ZLECOMP_ARENA_H
+#define ZLECOMP_ARENA_H
+
+#include <juce_core/juce_core.h>
+#include "../dsp_definitions.h"
+
+namespace zlarena {
+
+    /**
+     * a per-instance arena, all prepare-time buffers are planned first and then carved from one aligned allocation
+     * allocations large enough to span a huge page are aligned to it and marked for transparent huge pages (linux)
+     * plan and allocate off the audio thread only, get() is free to call anywhere
+     */
+    class Arena {
+    public:
+        auto static constexpr alignment = zldsp::cacheLineSize;
+        auto static constexpr hugePageSize = size_t(2) << 20;
+
+        Arena() = default;
+
+        ~Arena();
+
+        /**
+         * forget all planned blocks, the memory is kept for the next plan
+         */
+        inline void clear() { totalBytes = 0; }
+
+        /**
+         * plan a block of count elements, each block starts on its own cache line
+         * @return the offset of the block
+         */
+        template<typename T>
+        size_t add(size_t count) {
+            const auto offset = roundUp(totalBytes, alignment);
+            totalBytes = offset + count * sizeof(T);
+            return offset;
+        }
+
+        /**
+         * allocate (if the current memory is too small) and zero all planned blocks
+         */
+        void allocate();
+
+        template<typename T>
+        inline T *get(size_t offset) const {
+            return reinterpret_cast<T *>(data + offset);
+        }
+
+        /**
+         * @return the number of elements of T which fill whole cache lines and hold at least count elements
+         */
+        template<typename T>
+        static constexpr size_t getStride(size_t count) {
+            return roundUp(count * sizeof(T), alignment) / sizeof(T);
+        }
+
+        inline size_t getPlannedBytes() const { return totalBytes; }
+
+        inline size_t getAllocatedBytes() const { return capacity; }
+
+    private:
+        std::byte *data = nullptr;
+        size_t capacity = 0, totalBytes = 0, dataAlignment = alignment;
+
+        static constexpr size_t roundUp(size_t x, size_t a) { return (x + a - 1) / a * a; }
+
+        void release();
+
+        JUCE_DECLARE_NON_COPYABLE(Arena)
+    };
+
+} // zlarena
+
+#endif //ZLECOMP_ARENA_H
@@ -11,6 +11,8 @@
 #include "computer.h"
 
 namespace zlcomputer {
+    static_assert(alignof(Computer<float>) == zldsp::cacheLineSize && alignof(Computer<double>) == zldsp::cacheLineSize,
+                  "parameters and curves of computers should start on their own cache lines");
     template<typename FloatType>
     Computer<FloatType>::Computer(const Computer<FloatType> &c) {
         setThreshold(c.getThreshold());
@@ -19,46 +21,65 @@ namespace zlcomputer {
         setKneeD(c.getKneeD());
         setKneeS(c.getKneeS());
         setBound(c.getBound());
+        update();
     }
 
     template<typename FloatType>
     FloatType Computer<FloatType>::eval(FloatType x) {
-        if (x <= threshold - kneeW) {
+        const auto &curve = curves[curveIdx.load()];
+        if (x <= curve.xs[0]) {
             return x;
-        } else if (x >= threshold + kneeW) {
-            return juce::jlimit(x - bound.load(), x + bound.load(), x / ratio + (1 - 1 / ratio) * threshold);
+        } else if (x >= curve.xs[2]) {
+            return juce::jlimit(x - bound.load(), x + bound.load(), curve.slope * x + curve.intercept);
         } else {
-            try {
-                return juce::jlimit(x - bound.load(), x + bound.load(), cubic->operator()(x));
-            } catch (std::domain_error &e) {
-                return x;
-            } catch (...) {
-                return x;
-            }
+            const size_t i = x < curve.xs[1] ? 0 : 1;
+            const auto t = (x - curve.xs[i]) * curve.invH[i];
+            const auto &c = curve.coeffs[i];
+            return juce::jlimit(x - bound.load(), x + bound.load(), c[0] + t * (c[1] + t * (c[2] + t * c[3])));
         }
     }
 
     template<typename FloatType>
     FloatType Computer<FloatType>::process(FloatType x) {
-        return juce::Decibels::decibelsToGain(eval(x) - x);
+        return zlmath::decibelsToGain(eval(x) - x);
+    }
+
+    template<typename FloatType>
+    void Computer<FloatType>::setParameters(FloatType thresholdV, FloatType ratioV, FloatType kneeWV,
+                                            FloatType kneeDV, FloatType kneeSV, FloatType boundV) {
+        threshold.store(thresholdV);
+        ratio.store(ratioV);
+        kneeW.store(kneeWV);
+        kneeD.store(kneeDV);
+        kneeS.store(kneeSV);
+        bound.store(boundV);
+        interpolate();
     }
 
     template<typename FloatType>
     void Computer<FloatType>::interpolate() {
-        std::array initialX{threshold.load() - kneeW.load(),
-                            threshold.load(),
-                            threshold.load() + kneeW.load()};
-        std::array initialY{threshold.load() - kneeW.load(),
-                            threshold.load() - kneeD.load() * FloatType(0.75) * kneeW.load() *
-                                               (FloatType(1) - FloatType(0.5) / ratio.load() - FloatType(0.5)),
-                            threshold.load() + kneeW.load() / ratio.load()};
-        std::array initialYX{FloatType(1),
-                             kneeS.load() + (FloatType(1) - kneeS.load()) / ratio.load(),
-                             FloatType(1) / ratio.load()};
-        cubic = std::make_unique<boost::math::interpolators::cubic_hermite<std::array<FloatType, 3>>>(
-                std::move(initialX),
-                std::move(initialY),
-                std::move(initialYX));
+        const auto t = threshold.load(), w = kneeW.load(), r = ratio.load();
+        const auto d = kneeD.load(), s = kneeS.load();
+        const std::array xs{t - w, t, t + w};
+        const std::array ys{t - w,
+                            t - d * FloatType(0.75) * w * (FloatType(1) - FloatType(0.5) / r - FloatType(0.5)),
+                            t + w / r};
+        const std::array ms{FloatType(1), s + (FloatType(1) - s) / r, FloatType(1) / r};
+
+        auto &curve = curves[1 - curveIdx.load()];
+        curve.xs = xs;
+        for (size_t i = 0; i < 2; ++i) {
+            // y(u) = c0 + c1 * u + c2 * u^2 + c3 * u^3, u = (x - xs[i]) / h
+            const auto h = xs[i + 1] - xs[i];
+            const auto m0 = h * ms[i], m1 = h * ms[i + 1];
+            curve.invH[i] = FloatType(1) / h;
+            curve.coeffs[i] = {ys[i], m0,
+                               FloatType(3) * (ys[i + 1] - ys[i]) - FloatType(2) * m0 - m1,
+                               FloatType(2) * (ys[i] - ys[i + 1]) + m0 + m1};
+        }
+        curve.slope = FloatType(1) / r;
+        curve.intercept = (FloatType(1) - FloatType(1) / r) * t;
+        curveIdx.store(1 - curveIdx.load());
     }
 
     template
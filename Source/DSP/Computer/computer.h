@@ -11,9 +11,8 @@
 #ifndef ZLECOMP_COMPUTER_H
 #define ZLECOMP_COMPUTER_H
 
-#include <boost/circular_buffer.hpp>
-#include <boost/math/interpolators/cubic_hermite.hpp>
 #include "../dsp_definitions.h"
+#include "../FastMath/fast_db.h"
 
 namespace zlcomputer {
 
@@ -30,35 +29,35 @@ namespace zlcomputer {
 
         inline void setThreshold(FloatType v) {
             threshold.store(v);
-            interpolate();
+            toUpdate.store(true);
         }
 
         inline FloatType getThreshold() const { return threshold.load(); }
 
         inline void setRatio(FloatType v) {
             ratio.store(v);
-            interpolate();
+            toUpdate.store(true);
         }
 
         inline FloatType getRatio() const { return ratio.load();}
 
         inline void setKneeW(FloatType v) {
             kneeW.store(v);
-            interpolate();
+            toUpdate.store(true);
         }
 
         inline FloatType getKneeW() const {return kneeW.load();}
 
         inline void setKneeD(FloatType v) {
             kneeD.store(v);
-            interpolate();
+            toUpdate.store(true);
         }
 
         inline FloatType getKneeD() const {return kneeD.load();}
 
         inline void setKneeS(FloatType v) {
             kneeS.store(v);
-            interpolate();
+            toUpdate.store(true);
         }
 
         inline FloatType getKneeS() const {return kneeS.load();}
@@ -69,12 +68,47 @@ namespace zlcomputer {
 
         inline FloatType getBound() const {return bound.load();}
 
+        /**
+         * rebuild the curve if any parameter has changed, call it from the audio thread before processing
+         * the setters above only store the values, so they are wait-free on any thread
+         */
+        inline void update() {
+            if (toUpdate.exchange(false)) {
+                interpolate();
+            }
+        }
+
+        /**
+         * set all curve parameters at once and rebuild the curve immediately
+         * only call it from the audio thread, which is the only thread that rebuilds the curve
+         */
+        void setParameters(FloatType thresholdV, FloatType ratioV, FloatType kneeWV,
+                           FloatType kneeDV, FloatType kneeSV, FloatType boundV);
+
+        zldsp::Layout getLayout() const {
+            return {zldsp::getOffset(this, &threshold), zldsp::getOffset(this, &toUpdate) + sizeof(toUpdate),
+                    zldsp::getOffset(this, &curves), sizeof(*this)};
+        }
+
     private:
-        std::atomic<FloatType> threshold = zldsp::threshold::defaultV, ratio = zldsp::ratio::defaultV;
+        // parameters, written by the message thread
+        alignas(zldsp::cacheLineSize) std::atomic<FloatType> threshold = zldsp::threshold::defaultV;
+        std::atomic<FloatType> ratio = zldsp::ratio::defaultV;
         std::atomic<FloatType> kneeW = zldsp::kneeW::formatV(
                 zldsp::kneeW::defaultV), kneeD = zldsp::kneeD::defaultV, kneeS = zldsp::kneeS::defaultV;
         std::atomic<FloatType> bound = zldsp::bound::defaultV;
-        std::unique_ptr<boost::math::interpolators::cubic_hermite<std::array<FloatType, 3>>> cubic;
+        std::atomic<bool> toUpdate{false};
+        // two cubic hermite segments of the knee, [threshold - kneeW, threshold] and [threshold, threshold + kneeW]
+        // the curve is double-buffered, a new curve is written to the inactive one and then swapped in
+        struct Curve {
+            std::array<FloatType, 3> xs{};
+            std::array<FloatType, 2> invH{};
+            std::array<std::array<FloatType, 4>, 2> coeffs{};
+            FloatType slope{1}, intercept{0};
+        };
+        alignas(zldsp::cacheLineSize) std::array<Curve, 2> curves;
+        std::atomic<size_t> curveIdx{0};
+
         void interpolate();
     };
 
@@ -0,0 +1,142 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "crossover.h"
+
+namespace zlcrossover {
+    template<typename FloatType>
+    CrossoverBank<FloatType>::CrossoverBank() {
+        freqs[0].store(zldsp::crossover1::defaultV);
+        freqs[1].store(zldsp::crossover2::defaultV);
+        freqs[2].store(zldsp::crossover3::defaultV);
+        freqs[3].store(zldsp::crossover4::defaultV);
+    }
+
+    template<typename FloatType>
+    void CrossoverBank<FloatType>::prepare(double sampleRate, size_t lanes) {
+        fs = sampleRate;
+        numLanes = juce::jmin(lanes, static_cast<size_t>(maxLaneNum));
+        toUpdate.store(true);
+        reset();
+    }
+
+    template<typename FloatType>
+    void CrossoverBank<FloatType>::reset() {
+        for (auto &state: lowStates) {
+            state = SVFState();
+        }
+        for (auto &state: highStates) {
+            state = SVFState();
+        }
+        for (auto &states: allStates) {
+            for (auto &state: states) {
+                state = SVFState();
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void CrossoverBank<FloatType>::setBandNum(size_t n) {
+        numBands.store(juce::jlimit(size_t(1), static_cast<size_t>(zldsp::maxBandNum), n));
+        reset();
+    }
+
+    template<typename FloatType>
+    void CrossoverBank<FloatType>::setFreq(size_t idx, FloatType v) {
+        freqs[idx].store(v);
+        toUpdate.store(true);
+    }
+
+    template<typename FloatType>
+    void CrossoverBank<FloatType>::updateCoefficients() {
+        // keep crossover frequencies ascending and below nyquist
+        auto lowerBound = FloatType(10);
+        const auto upperBound = static_cast<FloatType>(fs * 0.45);
+        for (size_t k = 0; k < freqs.size(); ++k) {
+            const auto freq = juce::jlimit(lowerBound, upperBound, freqs[k].load());
+            lowerBound = freq;
+            const auto g = static_cast<FloatType>(std::tan(juce::MathConstants<double>::pi * freq / fs));
+            gs[k] = g;
+            hs[k] = FloatType(1) / (FloatType(1) + R2 * g + g * g);
+        }
+    }
+
+    template<typename FloatType>
+    void CrossoverBank<FloatType>::process(std::array<FloatType *, zldsp::maxBandNum> &bands, size_t numSamples) {
+        if (toUpdate.exchange(false)) {
+            updateCoefficients();
+        }
+        const auto n = numBands.load();
+        if (n < 2) {
+            return;
+        }
+        // split the remaining high part at each crossover
+        auto *rest = bands[n - 1];
+        for (size_t k = 0; k + 1 < n; ++k) {
+            splitStage(k, rest, bands[k], numSamples);
+        }
+        // compensate phase of lower bands with the all-pass of each higher crossover
+        for (size_t j = 0; j + 2 < n; ++j) {
+            for (size_t k = j + 1; k + 1 < n; ++k) {
+                allPassStage(k, allStates[j][k], bands[j], numSamples);
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void CrossoverBank<FloatType>::splitStage(size_t k, FloatType *rest, FloatType *low, size_t numSamples) {
+        const auto g = gs[k], h = hs[k], gR = R2 + g;
+        auto &s1 = lowStates[k].s1, &s2 = lowStates[k].s2;
+        auto &s3 = highStates[k].s1, &s4 = highStates[k].s2;
+        for (size_t n = 0; n < numSamples; ++n) {
+            auto *x = rest + n * numLanes;
+            auto *y = low + n * numLanes;
+            for (size_t i = 0; i < numLanes; ++i) {
+                const auto yH = (x[i] - gR * s1[i] - s2[i]) * h;
+                const auto yB = g * yH + s1[i];
+                s1[i] = g * yH + yB;
+                const auto yL = g * yB + s2[i];
+                s2[i] = g * yB + yL;
+
+                const auto yH2 = (yL - gR * s3[i] - s4[i]) * h;
+                const auto yB2 = g * yH2 + s3[i];
+                s3[i] = g * yH2 + yB2;
+                const auto yL2 = g * yB2 + s4[i];
+                s4[i] = g * yB2 + yL2;
+
+                y[i] = yL2;
+                x[i] = yL - R2 * yB + yH - yL2;
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void CrossoverBank<FloatType>::allPassStage(size_t k, SVFState &state, FloatType *band, size_t numSamples) {
+        const auto g = gs[k], h = hs[k], gR = R2 + g;
+        auto &s1 = state.s1, &s2 = state.s2;
+        for (size_t n = 0; n < numSamples; ++n) {
+            auto *x = band + n * numLanes;
+            for (size_t i = 0; i < numLanes; ++i) {
+                const auto yH = (x[i] - gR * s1[i] - s2[i]) * h;
+                const auto yB = g * yH + s1[i];
+                s1[i] = g * yH + yB;
+                const auto yL = g * yB + s2[i];
+                s2[i] = g * yB + yL;
+                x[i] = yL - R2 * yB + yH;
+            }
+        }
+    }
+
+    template
+    class CrossoverBank<float>;
+
+    template
+    class CrossoverBank<double>;
+} // zlcrossover
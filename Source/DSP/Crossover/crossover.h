@@ -0,0 +1,82 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#ifndef ZLECOMP_CROSSOVER_H
+#define ZLECOMP_CROSSOVER_H
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include "../dsp_definitions.h"
+
+namespace zlcrossover {
+
+    /**
+     * a bank of 4th order Linkwitz-Riley crossovers which splits the signal into up to zldsp::maxBandNum bands
+     * all lanes (channels) are interleaved, so that each stage runs across all lanes at once
+     * lower bands pass through the all-pass filters of the higher crossovers, so the bands sum to an all-pass
+     */
+    template<typename FloatType>
+    class CrossoverBank {
+    public:
+        auto static constexpr maxLaneNum = zldsp::maxChannelNum * 2;
+
+        CrossoverBank();
+
+        void prepare(double sampleRate, size_t lanes);
+
+        void reset();
+
+        void setBandNum(size_t n);
+
+        inline size_t getBandNum() const { return numBands.load(); }
+
+        void setFreq(size_t idx, FloatType v);
+
+        /**
+         * the crossovers are minimum-phase, they do not add any latency
+         */
+        inline int getLatencySamples() const { return 0; }
+
+        /**
+         * split the signal into bands
+         * @param bands interleaved buffers of each band, the input should be placed in bands[getBandNum() - 1]
+         * @param numSamples number of samples
+         */
+        void process(std::array<FloatType *, zldsp::maxBandNum> &bands, size_t numSamples);
+
+    private:
+        struct SVFState {
+            std::array<FloatType, maxLaneNum> s1{}, s2{};
+        };
+
+        std::atomic<size_t> numBands = 1;
+        std::array<std::atomic<FloatType>, zldsp::maxBandNum - 1> freqs;
+        std::atomic<bool> toUpdate = true;
+        double fs = 44100;
+        size_t numLanes = 2;
+
+        std::array<FloatType, zldsp::maxBandNum - 1> gs{}, hs{};
+        // two cascaded SVFs for each crossover
+        std::array<SVFState, zldsp::maxBandNum - 1> lowStates, highStates;
+        // all-pass SVF of crossover k applied on band j, k > j
+        std::array<std::array<SVFState, zldsp::maxBandNum - 1>, zldsp::maxBandNum - 1> allStates;
+
+        inline auto static const R2 = static_cast<FloatType>(juce::MathConstants<double>::sqrt2);
+
+        void updateCoefficients();
+
+        void splitStage(size_t k, FloatType *rest, FloatType *low, size_t numSamples);
+
+        void allPassStage(size_t k, SVFState &state, FloatType *band, size_t numSamples);
+    };
+
+} // zlcrossover
+
+#endif //ZLECOMP_CROSSOVER_H
@@ -0,0 +1,94 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "latency_graph.h"
+
+namespace zldelay {
+    template<typename FloatType>
+    int LatencyGraph<FloatType>::getCapacity(const juce::dsp::ProcessSpec &spec, int maxDelay) {
+        // power of two capacity, so that wrapping is a mask
+        return juce::nextPowerOfTwo(maxDelay + static_cast<int>(spec.maximumBlockSize));
+    }
+
+    template<typename FloatType>
+    void LatencyGraph<FloatType>::prepare(const juce::dsp::ProcessSpec &spec, int maxDelay,
+                                          FloatType *const *channels) {
+        capacity = getCapacity(spec, maxDelay);
+        mask = capacity - 1;
+        maxTapDelay = capacity - static_cast<int>(spec.maximumBlockSize);
+        delayBuffer.setDataToReferTo(channels, static_cast<int>(spec.numChannels), capacity);
+        reset();
+        updateTaps();
+    }
+
+    template<typename FloatType>
+    void LatencyGraph<FloatType>::reset() {
+        delayBuffer.clear();
+        writePos = 0;
+        lastNumSamples = 0;
+    }
+
+    template<typename FloatType>
+    void LatencyGraph<FloatType>::setStageLatency(size_t stage, int numSamples) {
+        stageLatencies[stage].store(numSamples);
+        updateTaps();
+    }
+
+    template<typename FloatType>
+    void LatencyGraph<FloatType>::setAudit(bool f) {
+        audit.store(f);
+        updateTaps();
+    }
+
+    template<typename FloatType>
+    void LatencyGraph<FloatType>::updateTaps() {
+        const auto lookahead = stageLatencies[lookaheadStage].load();
+        const auto chain = stageLatencies[overSampleStage].load() + stageLatencies[segmentStage].load() +
+                           stageLatencies[crossoverStage].load();
+        tapDelays[lookaheadTap].store(juce::jlimit(0, maxTapDelay, lookahead));
+        tapDelays[dryTap].store(juce::jlimit(0, maxTapDelay, lookahead + chain));
+        tapDelays[bypassTap].store(juce::jlimit(0, maxTapDelay, audit.load() ? chain : lookahead + chain));
+    }
+
+    template<typename FloatType>
+    void LatencyGraph<FloatType>::push(const juce::AudioBuffer<FloatType> &buffer) {
+        const auto numChannels = juce::jmin(buffer.getNumChannels(), delayBuffer.getNumChannels());
+        const auto numSamples = buffer.getNumSamples();
+        const auto firstPart = juce::jmin(numSamples, capacity - writePos);
+        for (int i = 0; i < numChannels; ++i) {
+            delayBuffer.copyFrom(i, writePos, buffer, i, 0, firstPart);
+            if (firstPart < numSamples) {
+                delayBuffer.copyFrom(i, 0, buffer, i, firstPart, numSamples - firstPart);
+            }
+        }
+        writePos = (writePos + numSamples) & mask;
+        lastNumSamples = numSamples;
+    }
+
+    template<typename FloatType>
+    void LatencyGraph<FloatType>::read(size_t tap, juce::AudioBuffer<FloatType> &buffer) const {
+        const auto numChannels = juce::jmin(buffer.getNumChannels(), delayBuffer.getNumChannels());
+        const auto numSamples = juce::jmin(buffer.getNumSamples(), lastNumSamples);
+        const auto readPos = (writePos - lastNumSamples - tapDelays[tap].load()) & mask;
+        const auto firstPart = juce::jmin(numSamples, capacity - readPos);
+        for (int i = 0; i < numChannels; ++i) {
+            buffer.copyFrom(i, 0, delayBuffer, i, readPos, firstPart);
+            if (firstPart < numSamples) {
+                buffer.copyFrom(i, firstPart, delayBuffer, i, 0, numSamples - firstPart);
+            }
+        }
+    }
+
+    template
+    class LatencyGraph<float>;
+
+    template
+    class LatencyGraph<double>;
+} // zldelay
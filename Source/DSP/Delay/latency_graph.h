@@ -0,0 +1,100 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#ifndef ZLECOMP_LATENCY_GRAPH_H
+#define ZLECOMP_LATENCY_GRAPH_H
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include "../dsp_definitions.h"
+
+namespace zldelay {
+
+    /**
+     * keep track of the latency of each stage and align all paths with one shared multi-tap delay
+     * the input is written once, each tap reads it back with its own delay
+     * - lookahead: the main path, delayed by the lookahead
+     * - dry: the dry path, aligned with the wet output of the chain
+     * - bypass: the input delayed by the reported latency
+     */
+    template<typename FloatType>
+    class LatencyGraph {
+    public:
+        enum {
+            lookaheadStage, overSampleStage, segmentStage, crossoverStage, stageNUM
+        };
+
+        enum {
+            lookaheadTap, dryTap, bypassTap, tapNUM
+        };
+
+        LatencyGraph() = default;
+
+        /**
+         * @param spec process spec
+         * @param maxDelay the largest delay of any tap in samples
+         * @return the number of samples each channel of the shared delay buffer should hold
+         */
+        static int getCapacity(const juce::dsp::ProcessSpec &spec, int maxDelay);
+
+        /**
+         * let the shared delay buffer refer to external channels, each of them holds getCapacity() samples
+         * @param spec process spec
+         * @param maxDelay the largest delay of any tap in samples
+         * @param channels the channels of the delay buffer
+         */
+        void prepare(const juce::dsp::ProcessSpec &spec, int maxDelay, FloatType *const *channels);
+
+        void reset();
+
+        void setStageLatency(size_t stage, int numSamples);
+
+        inline int getStageLatency(size_t stage) const { return stageLatencies[stage].load(); }
+
+        /**
+         * in audit mode the side-chain is the output, which does not pass the lookahead
+         */
+        void setAudit(bool f);
+
+        /**
+         * @return the latency that should be reported to the host
+         */
+        inline int getLatency() const { return tapDelays[bypassTap].load(); }
+
+        inline int getTapDelay(size_t tap) const { return tapDelays[tap].load(); }
+
+        /**
+         * write a block of input into the delay buffer, call it once per block before reading taps
+         */
+        void push(const juce::AudioBuffer<FloatType> &buffer);
+
+        /**
+         * read the last pushed block from a tap
+         */
+        void read(size_t tap, juce::AudioBuffer<FloatType> &buffer) const;
+
+        inline size_t getMemoryBytes() const {
+            return static_cast<size_t>(delayBuffer.getNumChannels()) *
+                   static_cast<size_t>(delayBuffer.getNumSamples()) * sizeof(FloatType);
+        }
+
+    private:
+        juce::AudioBuffer<FloatType> delayBuffer;
+        int capacity = 1, mask = 0, writePos = 0, lastNumSamples = 0, maxTapDelay = 0;
+        std::array<std::atomic<int>, stageNUM> stageLatencies{};
+        std::array<std::atomic<int>, tapNUM> tapDelays{};
+        std::atomic<bool> audit{false};
+
+        void updateTaps();
+    };
+
+} // zldelay
+
+#endif //ZLECOMP_LATENCY_GRAPH_H
@@ -11,6 +11,8 @@
 #include "detector.h"
 
 namespace zldetector {
+    static_assert(alignof(Detector<float>) == zldsp::cacheLineSize && alignof(Detector<double>) == zldsp::cacheLineSize,
+                  "parameters and states of detectors should start on their own cache lines");
 
     template<typename FloatType>
     Detector<FloatType>::Detector(const Detector<FloatType> &d) {
@@ -20,28 +22,79 @@ namespace zldetector {
         setAttack(d.getAttack());
         setRelease(d.getRelease());
         setSmooth(d.getSmooth());
+        reset();
     }
 
+    template<typename FloatType>
+    const std::array<typename Detector<FloatType>::LanesFunc, styleNUM * styleNUM> Detector<FloatType>::lanesFuncs =
+            []<size_t... I>(std::index_sequence<I...>) {
+                return std::array<LanesFunc, styleNUM * styleNUM>{
+                        &Detector<FloatType>::processLanes<I / styleNUM, I % styleNUM>...};
+            }(std::make_index_sequence<styleNUM * styleNUM>{});
+
     template<typename FloatType>
     FloatType Detector<FloatType>::process(FloatType target) {
-        bool ra = ((xC < target) == (phase.load() == Detector::gain));
-        FloatType para = ra ? rPara.load() : aPara.load();
-        size_t style = ra ? rStyle.load() : aStyle.load();
-        FloatType distanceS = target - xS;
-        FloatType distanceC = xS * smooth.load() + target * (1 - smooth.load()) - xC;
-        FloatType slopeS = juce::jmin(para * std::abs(funcs<FloatType>[style](std::abs(distanceS))), std::abs(distanceS));
-        FloatType slopeC = juce::jmin(para * std::abs(funcs<FloatType>[style](std::abs(distanceC))), std::abs(target - xC));
-        xS += slopeS * sgn(distanceS);
-        xC += slopeC * sgn(distanceC);
-        xS = juce::jmax(xS, FloatType(1e-5));
-        xC = juce::jmax(xC, FloatType(1e-5));
-        return xC;
+        process(&target, 1);
+        return target;
+    }
+
+    template<typename FloatType>
+    void Detector<FloatType>::process(FloatType *targets, size_t numLanes) {
+        // load parameters once for all lanes
+        const auto func = lanesFuncs[aStyle.load() * styleNUM + rStyle.load()];
+        (this->*func)(targets, targets, numLanes, phase.load() == Detector::gain,
+                      aPara.load(), rPara.load(), smooth.load());
+    }
+
+    template<typename FloatType>
+    void Detector<FloatType>::advance(FloatType target, size_t numLanes, size_t numSteps) {
+        const auto func = lanesFuncs[aStyle.load() * styleNUM + rStyle.load()];
+        const auto isGainPhase = phase.load() == Detector::gain;
+        const StateType aP = aPara.load(), rP = rPara.load();
+        const StateType s = smooth.load();
+        std::array<FloatType, zldsp::maxChannelNum> targets{}, outputs{};
+        std::fill(targets.begin(), targets.begin() + static_cast<std::ptrdiff_t>(numLanes), target);
+        const auto settled = juce::jmax(static_cast<StateType>(target), StateType(1e-5));
+        for (size_t n = 0; n < numSteps; ++n) {
+            (this->*func)(targets.data(), outputs.data(), numLanes, isGainPhase, aP, rP, s);
+            bool isSettled = true;
+            for (size_t i = 0; i < numLanes; ++i) {
+                isSettled = isSettled & (std::abs(xC[i] - settled) < StateType(1e-6)) &
+                            (std::abs(xS[i] - settled) < StateType(1e-6));
+            }
+            if (isSettled) {
+                return;
+            }
+        }
+    }
+
+    template<typename FloatType>
+    template<size_t aS, size_t rS>
+    void Detector<FloatType>::processLanes(const FloatType *targets, FloatType *outputs, size_t numLanes,
+                                           bool isGainPhase, StateType aP, StateType rP, StateType s) {
+        // both styles are evaluated and selected with bit masks, so that the loop has no branches
+        for (size_t i = 0; i < numLanes; ++i) {
+            const auto target = static_cast<StateType>(targets[i]);
+            const auto c = xC[i], x = xS[i];
+            const auto ra = zlmath::toMask<StateType>((c < target) == isGainPhase);
+            const auto para = zlmath::select(ra, rP, aP);
+            const auto distanceS = target - x;
+            const auto distanceC = x * s + target * (1 - s) - c;
+            const auto absS = std::abs(distanceS), absC = std::abs(distanceC);
+            const auto funcS = zlmath::select(ra, iterate<StateType, rS>(absS), iterate<StateType, aS>(absS));
+            const auto funcC = zlmath::select(ra, iterate<StateType, rS>(absC), iterate<StateType, aS>(absC));
+            const auto slopeS = std::min(para * std::abs(funcS), absS);
+            const auto slopeC = std::min(para * std::abs(funcC), std::abs(target - c));
+            xS[i] = std::max(x + slopeS * sgn(distanceS), StateType(1e-5));
+            xC[i] = std::max(c + slopeC * sgn(distanceC), StateType(1e-5));
+            outputs[i] = static_cast<FloatType>(xC[i]);
+        }
     }
 
     template<typename FloatType>
     void Detector<FloatType>::reset() {
-        xC = 1.0;
-        xS = 1.0;
+        std::fill(xC.begin(), xC.end(), StateType(1));
+        std::fill(xS.begin(), xS.end(), StateType(1));
     }
 
     template<typename FloatType>
@@ -14,6 +14,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "../dsp_definitions.h"
+#include "../FastMath/fast_db.h"
 #include "iter_funcs.h"
 
 namespace zldetector {
@@ -25,7 +26,7 @@ namespace zldetector {
             gain, level, phaseNUM
         };
 
-        Detector() = default;
+        Detector() { reset(); }
 
         Detector(const Detector<FloatType> &d);
 
@@ -35,6 +36,21 @@ namespace zldetector {
 
         FloatType process(FloatType target);
 
+        /**
+         * attack/release each lane towards its target, results are written back in place
+         * @param targets one target per lane (channel)
+         * @param numLanes number of active lanes, at most zldsp::maxChannelNum
+         */
+        void process(FloatType *targets, size_t numLanes);
+
+        /**
+         * attack/release each lane towards a constant target for several steps, stop early once settled
+         * @param target the target of all lanes
+         * @param numLanes number of active lanes, at most zldsp::maxChannelNum
+         * @param numSteps number of steps
+         */
+        void advance(FloatType target, size_t numLanes, size_t numSteps);
+
         inline void setAStyle(size_t idx) { aStyle.store(idx); }
 
         inline size_t getAStyle() const { return aStyle.load(); }
@@ -73,14 +89,36 @@ namespace zldetector {
 
         inline void setPhase(size_t idx) { phase.store(idx); }
 
+        zldsp::Layout getLayout() const {
+            return {zldsp::getOffset(this, &aStyle), zldsp::getOffset(this, &deltaT) + sizeof(deltaT),
+                    zldsp::getOffset(this, &xC), sizeof(*this)};
+        }
+
     private:
-        std::atomic<size_t> aStyle, rStyle, phase;
+        // parameters, written by the message thread
+        alignas(zldsp::cacheLineSize) std::atomic<size_t> aStyle;
+        std::atomic<size_t> rStyle, phase;
         std::atomic<FloatType> attack, release, aPara, rPara, smooth;
         std::atomic<FloatType> deltaT = FloatType(1) / FloatType(44100);
-        FloatType xC = 1.0, xS = 1.0;
+        // states, only touched by the audio thread
+        using StateType = zldsp::StateType<FloatType>;
+        alignas(zldsp::cacheLineSize) std::array<StateType, zldsp::maxChannelNum> xC{};
+        std::array<StateType, zldsp::maxChannelNum> xS{};
+
+        /**
+         * one branch-free pass over the lanes, with the attack/release styles fixed at compile time
+         */
+        template<size_t aS, size_t rS>
+        void processLanes(const FloatType *targets, FloatType *outputs, size_t numLanes,
+                          bool isGainPhase, StateType aP, StateType rP, StateType s);
+
+        using LanesFunc = void (Detector::*)(const FloatType *, FloatType *, size_t,
+                                             bool, StateType, StateType, StateType);
+
+        static const std::array<LanesFunc, styleNUM * styleNUM> lanesFuncs;
 
-        inline static FloatType sgn(FloatType val) {
-            return (FloatType(0) < val) - (val < FloatType(0));
+        inline static StateType sgn(StateType val) {
+            return (StateType(0) < val) - (val < StateType(0));
         }
     };
 
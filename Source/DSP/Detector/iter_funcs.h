@@ -21,14 +21,23 @@ namespace zldetector {
         classic, style1, style2, style3, style4, styleNUM
     };
 
-    template<typename FloatType>
-    static std::array<std::function<FloatType(FloatType)>, iterType::styleNUM> funcs = {
-            [](FloatType x) { return x; },
-            [](FloatType x) { return x * (FloatType(0.5) + (FloatType(1.5) - x) * x); },
-            [](FloatType x) { return std::sin(x * juce::MathConstants<FloatType>::halfPi); },
-            [](FloatType x) { return std::sin(x * juce::MathConstants<FloatType>::halfPi) - x; },
-            [](FloatType x) { return x * (1 - x); }
-    };
+    /**
+     * the iteration function of each style, the style is a template argument so that it can be inlined
+     */
+    template<typename FloatType, size_t style>
+    inline FloatType iterate(FloatType x) {
+        if constexpr (style == classic) {
+            return x;
+        } else if constexpr (style == style1) {
+            return x * (FloatType(0.5) + (FloatType(1.5) - x) * x);
+        } else if constexpr (style == style2) {
+            return std::sin(x * juce::MathConstants<FloatType>::halfPi);
+        } else if constexpr (style == style3) {
+            return std::sin(x * juce::MathConstants<FloatType>::halfPi) - x;
+        } else {
+            return x * (1 - x);
+        }
+    }
 
     template<typename FloatType>
     static const std::array<FloatType, iterType::styleNUM> scales0 = {
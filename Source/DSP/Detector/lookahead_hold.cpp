@@ -0,0 +1,107 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "lookahead_hold.h"
+
+namespace zldetector {
+    template<typename FloatType>
+    void LookaheadHold<FloatType>::prepare(size_t numLanes, FloatType *values, size_t *steps) {
+        lanes = numLanes;
+        dequeValues = values;
+        averageValues = dequeValues + maxSlotNum * lanes;
+        strideMins = averageValues + maxSlotNum * lanes;
+        outputs = strideMins + lanes;
+        sums = outputs + lanes;
+        dequeSteps = steps;
+        dequeHeads = dequeSteps + maxSlotNum * lanes;
+        dequeSizes = dequeHeads + lanes;
+        reset();
+    }
+
+    template<typename FloatType>
+    void LookaheadHold<FloatType>::setWindowSize(size_t windowSize) {
+        window = juce::jmax(size_t(1), windowSize);
+        stride = (window + maxSlotNum - 1) / maxSlotNum;
+        slots = (window + stride - 1) / stride;
+        reset();
+    }
+
+    template<typename FloatType>
+    void LookaheadHold<FloatType>::reset() {
+        step = 0;
+        pos = 0;
+        strideCount = 0;
+        std::fill(dequeHeads, dequeHeads + lanes, size_t(0));
+        std::fill(dequeSizes, dequeSizes + lanes, size_t(0));
+        std::fill(averageValues, averageValues + maxSlotNum * lanes, FloatType(1));
+        std::fill(strideMins, strideMins + lanes, std::numeric_limits<FloatType>::max());
+        std::fill(outputs, outputs + lanes, FloatType(1));
+        std::fill(sums, sums + lanes, static_cast<FloatType>(slots));
+    }
+
+    template<typename FloatType>
+    void LookaheadHold<FloatType>::process(FloatType *gains) {
+        if (window == 1) {
+            return;
+        }
+        // collect the minimum of the current slot, keep the last output until the slot is full
+        for (size_t i = 0; i < lanes; ++i) {
+            strideMins[i] = juce::jmin(strideMins[i], gains[i]);
+        }
+        strideCount += 1;
+        if (strideCount < stride) {
+            std::copy(outputs, outputs + lanes, gains);
+            return;
+        }
+        strideCount = 0;
+        const auto scale = FloatType(1) / static_cast<FloatType>(slots);
+        for (size_t i = 0; i < lanes; ++i) {
+            auto *values = dequeValues + i * maxSlotNum;
+            auto *steps = dequeSteps + i * maxSlotNum;
+            auto &head = dequeHeads[i], &size = dequeSizes[i];
+            const auto x = strideMins[i];
+            strideMins[i] = std::numeric_limits<FloatType>::max();
+            // drop values which are not smaller than the new one from the back
+            while (size > 0 && values[(head + size - 1) % slots] >= x) {
+                size -= 1;
+            }
+            // drop the front value if it has left the window
+            if (size > 0 && steps[head] + slots <= step) {
+                head = (head + 1) % slots;
+                size -= 1;
+            }
+            values[(head + size) % slots] = x;
+            steps[(head + size) % slots] = step;
+            size += 1;
+            // moving average of the held minimum
+            auto *average = averageValues + i * maxSlotNum;
+            sums[i] += values[head] - average[pos];
+            average[pos] = values[head];
+            outputs[i] = sums[i] * scale;
+        }
+        std::copy(outputs, outputs + lanes, gains);
+        step += 1;
+        pos += 1;
+        if (pos == slots) {
+            // recompute the running sums once per window to avoid drift
+            pos = 0;
+            for (size_t i = 0; i < lanes; ++i) {
+                const auto *average = averageValues + i * maxSlotNum;
+                sums[i] = std::accumulate(average, average + slots, FloatType(0));
+            }
+        }
+    }
+
+    template
+    class LookaheadHold<float>;
+
+    template
+    class LookaheadHold<double>;
+} // zldetector
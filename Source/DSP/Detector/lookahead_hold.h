@@ -0,0 +1,83 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#ifndef ZLECOMP_LOOKAHEAD_HOLD_H
+#define ZLECOMP_LOOKAHEAD_HOLD_H
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "../dsp_definitions.h"
+
+namespace zldetector {
+
+    /**
+     * hold the minimum gain of each lane over the lookahead window, then smooth it with a moving average
+     * the minimum uses a monotonic deque (amortized O(1)), the moving average uses a running sum
+     * so the cost does not depend on the window size
+     * windows longer than maxSlotNum segments are decimated: the deque takes the minimum of every stride segments
+     */
+    template<typename FloatType>
+    class LookaheadHold {
+    public:
+        auto static constexpr maxSlotNum = size_t(1024);
+
+        LookaheadHold() = default;
+
+        /**
+         * @return the number of values the hold needs for numLanes lanes
+         */
+        static constexpr size_t getValueNum(size_t numLanes) { return (2 * maxSlotNum + 3) * numLanes; }
+
+        /**
+         * @return the number of steps the hold needs for numLanes lanes
+         */
+        static constexpr size_t getStepNum(size_t numLanes) { return (maxSlotNum + 2) * numLanes; }
+
+        /**
+         * refer to storage which covers the largest window, e.g. carved from an arena, it does not allocate
+         * @param numLanes number of lanes (channels)
+         * @param values getValueNum(numLanes) values
+         * @param steps getStepNum(numLanes) steps
+         */
+        void prepare(size_t numLanes, FloatType *values, size_t *steps);
+
+        /**
+         * set the window size, it does not allocate
+         * @param windowSize window size in segments
+         */
+        void setWindowSize(size_t windowSize);
+
+        void reset();
+
+        inline size_t getWindowSize() const { return window; }
+
+        inline size_t getMemoryBytes() const {
+            return getValueNum(lanes) * sizeof(FloatType) + getStepNum(lanes) * sizeof(size_t);
+        }
+
+        /**
+         * hold and smooth the gains of all lanes in place
+         * @param gains one gain per lane
+         */
+        void process(FloatType *gains);
+
+    private:
+        size_t window = 1, lanes = 0;
+        // the deque holds slots of stride segments each
+        size_t stride = 1, slots = 1, strideCount = 0;
+        size_t step = 0, pos = 0;
+        // ring buffers of the deque and the moving average, one block of maxSlotNum for each lane
+        FloatType *dequeValues = nullptr, *averageValues = nullptr;
+        size_t *dequeSteps = nullptr, *dequeHeads = nullptr, *dequeSizes = nullptr;
+        FloatType *strideMins = nullptr, *outputs = nullptr, *sums = nullptr;
+    };
+
+} // zldetector
+
+#endif //ZLECOMP_LOOKAHEAD_HOLD_H
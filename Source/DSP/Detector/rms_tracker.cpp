@@ -44,14 +44,16 @@ namespace zldetector {
     void RMSTracker<FloatType>::process(const juce::AudioBuffer<FloatType> &buffer) {
         FloatType _ms = 0;
         for (auto channel = 0; channel < buffer.getNumChannels(); channel++) {
-            auto data = buffer.getReadPointer(channel);
-            for (auto i = 0; i < buffer.getNumSamples(); i++) {
-                _ms += data[i] * data[i];
-            }
+            _ms += zlkernel::sumOfSquares<FloatType>(buffer.getReadPointer(channel),
+                                                     static_cast<size_t>(buffer.getNumSamples()));
         }
 
         _ms = _ms / static_cast<FloatType> (buffer.getNumSamples());
+        processMeanSquare(_ms);
+    }
 
+    template<typename FloatType>
+    void RMSTracker<FloatType>::processMeanSquare(FloatType _ms) {
         if (loudnessBuffer.size() == loudnessBuffer.capacity()) {
             mLoudness -= loudnessBuffer.front();
         }
@@ -12,7 +12,10 @@
 #define ZLECOMP_RMS_TRACKER_H
 
 #include "tracker.h"
+#include "../dsp_definitions.h"
+#include "../FastMath/fast_db.h"
 #include "../FixedBuffer/fifo_audio_buffer.h"
+#include "../Kernel/simd_kernels.h"
 #include <boost/circular_buffer.hpp>
 
 namespace zldetector {
@@ -35,23 +38,23 @@ namespace zldetector {
         }
 
         inline FloatType getBufferPeak() override {
-            return juce::Decibels::gainToDecibels(peak);
+            return zlmath::gainToDecibels(peak);
         }
 
         inline FloatType getMomentaryLoudness() override {
             FloatType meanSquare = 0;
             if (loudnessBuffer.size() > 0) {
-                meanSquare = mLoudness / static_cast<FloatType>(loudnessBuffer.size());
+                meanSquare = static_cast<FloatType>(mLoudness / static_cast<StateType>(loudnessBuffer.size()));
             }
-            return juce::Decibels::gainToDecibels(meanSquare) * static_cast<FloatType>(0.5);
+            return zlmath::gainToDecibels(meanSquare) * static_cast<FloatType>(0.5);
         }
 
         inline FloatType getIntegratedLoudness() override {
             FloatType meanSquare = 0;
             if (numBuffer > 0) {
-                meanSquare = iLoudness / static_cast<FloatType>(numBuffer);
+                meanSquare = static_cast<FloatType>(iLoudness / static_cast<StateType>(numBuffer));
             }
-            return secondPerBuffer * juce::Decibels::gainToDecibels(meanSquare) *
+            return secondPerBuffer * zlmath::gainToDecibels(meanSquare) *
                    static_cast<FloatType>(0.5);
         }
 
@@ -61,9 +64,18 @@ namespace zldetector {
 
         void process(const juce::AudioBuffer<FloatType> &buffer) override;
 
+        /**
+         * push the mean square of a buffer which has been calculated outside
+         * @param meanSquare mean square value
+         */
+        void processMeanSquare(FloatType meanSquare);
+
     private:
+        using StateType = zldsp::StateType<FloatType>;
         size_t numBuffer = 0;
-        FloatType peak = 0, mLoudness = 0, iLoudness = 0;
+        FloatType peak = 0;
+        // running sums drift, keep them in the state precision
+        StateType mLoudness = 0, iLoudness = 0;
         FloatType secondPerBuffer = FloatType(0.01);
         boost::circular_buffer<FloatType> loudnessBuffer;
     };
@@ -0,0 +1,165 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#ifndef ZLECOMP_FAST_DB_H
+#define ZLECOMP_FAST_DB_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace zlmath {
+
+    /**
+     * log2/exp2 based dB conversions for the segment loop, with float and double variants
+     * float results are within 2e-5 dB, double results within 1e-12 dB (relative error of the gain alike)
+     * the input of log2 must be a positive normal number, the dB conversions take care of the rest
+     * there are no branches or loops inside, so that loops over these functions can be vectorized
+     */
+    template<typename FloatType>
+    struct FloatBits {
+        static_assert(std::is_floating_point_v<FloatType>);
+        using IntType = std::conditional_t<std::is_same_v<FloatType, float>, std::int32_t, std::int64_t>;
+        auto static constexpr mantissaBits = std::is_same_v<FloatType, float> ? 23 : 52;
+        auto static constexpr bias = std::is_same_v<FloatType, float> ? 127 : 1023;
+        auto static constexpr minExponent = static_cast<FloatType>(1 - bias);
+        auto static constexpr maxExponent = static_cast<FloatType>(bias);
+        // number of odd terms of the atanh series of log2 and terms of the taylor series of exp2
+        auto static constexpr logTerms = std::is_same_v<FloatType, float> ? size_t(4) : size_t(8);
+        auto static constexpr expTerms = std::is_same_v<FloatType, float> ? size_t(7) : size_t(13);
+    };
+
+    /**
+     * coefficients of atanh(s) / s = 1 + s^2 / 3 + s^4 / 5 + ... in s^2
+     */
+    template<typename FloatType, size_t N>
+    inline constexpr auto logCoeffs = [] {
+        std::array<FloatType, N> c{};
+        for (size_t k = 0; k < N; ++k) {
+            c[k] = FloatType(1) / static_cast<FloatType>(2 * k + 1);
+        }
+        return c;
+    }();
+
+    /**
+     * coefficients of exp(y) = 1 + y + y^2 / 2! + ...
+     */
+    template<typename FloatType, size_t N>
+    inline constexpr auto expCoeffs = [] {
+        std::array<FloatType, N> c{};
+        double factorial = 1;
+        for (size_t k = 0; k < N; ++k) {
+            factorial *= k > 0 ? static_cast<double>(k) : 1.0;
+            c[k] = static_cast<FloatType>(1.0 / factorial);
+        }
+        return c;
+    }();
+
+    /**
+     * evaluate a polynomial with Horner's method, unrolled at compile time
+     */
+    template<typename FloatType, size_t N>
+    inline FloatType horner(FloatType x, const std::array<FloatType, N> &c) {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            auto p = c[N - 1];
+            ((p = p * x + c[N - 2 - I]), ...);
+            return p;
+        }(std::make_index_sequence<N - 1>{});
+    }
+
+    template<typename FloatType>
+    inline FloatType log2(FloatType x) {
+        using Bits = FloatBits<FloatType>;
+        using IntType = typename Bits::IntType;
+        // split x = m * 2^e with m in [sqrt(0.5), sqrt(2)), offsetting the bits by those of sqrt(0.5)
+        const auto offset = std::bit_cast<IntType>(FloatType(0.70710678118654752));
+        const auto i = std::bit_cast<IntType>(x) - offset;
+        const auto e = i >> Bits::mantissaBits;
+        const auto m = std::bit_cast<FloatType>((i & ((IntType(1) << Bits::mantissaBits) - 1)) + offset);
+        // log2(m) = 2 / ln2 * atanh(s), s = (m - 1) / (m + 1), |s| < 0.172
+        const auto s = (m - FloatType(1)) / (m + FloatType(1));
+        const auto p = horner(s * s, logCoeffs<FloatType, Bits::logTerms>);
+        return static_cast<FloatType>(e) + FloatType(2.8853900817779268) * s * p;
+    }
+
+    /**
+     * select a where mask is set and b elsewhere, with bit operations instead of a branch
+     * the compiler may turn a ternary with a float comparison into branches, which stops vectorization
+     */
+    template<typename FloatType>
+    inline FloatType select(typename FloatBits<FloatType>::IntType mask, FloatType a, FloatType b) {
+        using IntType = typename FloatBits<FloatType>::IntType;
+        return std::bit_cast<FloatType>((std::bit_cast<IntType>(a) & mask) | (std::bit_cast<IntType>(b) & ~mask));
+    }
+
+    template<typename FloatType>
+    inline typename FloatBits<FloatType>::IntType toMask(bool f) {
+        return -static_cast<typename FloatBits<FloatType>::IntType>(f);
+    }
+
+    template<typename FloatType>
+    inline FloatType exp2(FloatType x) {
+        using Bits = FloatBits<FloatType>;
+        using IntType = typename Bits::IntType;
+        const auto lowMask = toMask<FloatType>(x < Bits::minExponent);
+        const auto highMask = toMask<FloatType>(x > Bits::maxExponent);
+        const auto xc = select(highMask, Bits::maxExponent, select(lowMask, Bits::minExponent, x));
+        // split x = e + f with f in [-0.5, 0.5), xc + 0.5 - minExponent is positive so the cast rounds down
+        const auto e = static_cast<IntType>(xc + (FloatType(0.5) - Bits::minExponent)) + IntType(1 - Bits::bias);
+        // 2^f = exp(f * ln2)
+        const auto y = (xc - static_cast<FloatType>(e)) * FloatType(0.69314718055994531);
+        const auto p = horner(y, expCoeffs<FloatType, Bits::expTerms>);
+        const auto r = p * std::bit_cast<FloatType>((e + IntType(Bits::bias)) << Bits::mantissaBits);
+        return select(lowMask, FloatType(0), r);
+    }
+
+    /**
+     * same as juce::Decibels::gainToDecibels
+     */
+    template<typename FloatType>
+    inline FloatType gainToDecibels(FloatType gain, FloatType minusInfinityDb = FloatType(-100)) {
+        // 20 * log10(2)
+        const auto dB = FloatType(6.0205999132796239) * log2(gain);
+        return select(toMask<FloatType>((gain > FloatType(0)) & (dB > minusInfinityDb)), dB, minusInfinityDb);
+    }
+
+    /**
+     * same as juce::Decibels::decibelsToGain
+     */
+    template<typename FloatType>
+    inline FloatType decibelsToGain(FloatType dB, FloatType minusInfinityDb = FloatType(-100)) {
+        // log2(10) / 20
+        const auto gain = exp2(FloatType(0.16609640474436813) * dB);
+        return select(toMask<FloatType>(dB > minusInfinityDb), gain, FloatType(0));
+    }
+
+    /**
+     * convert several values in place
+     */
+    template<typename FloatType>
+    inline void gainToDecibels(FloatType *x, size_t num, FloatType minusInfinityDb = FloatType(-100)) {
+        for (size_t i = 0; i < num; ++i) {
+            x[i] = gainToDecibels(x[i], minusInfinityDb);
+        }
+    }
+
+    template<typename FloatType>
+    inline void decibelsToGain(FloatType *x, size_t num, FloatType minusInfinityDb = FloatType(-100)) {
+        for (size_t i = 0; i < num; ++i) {
+            x[i] = decibelsToGain(x[i], minusInfinityDb);
+        }
+    }
+
+} // zlmath
+
+#endif //ZLECOMP_FAST_DB_H
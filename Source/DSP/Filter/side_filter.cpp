@@ -0,0 +1,195 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "side_filter.h"
+
+namespace zlfilter {
+    template<typename FloatType>
+    void SideFilter<FloatType>::prepare(const juce::dsp::ProcessSpec &spec) {
+        fs = spec.sampleRate;
+        numLanes = juce::jmin(static_cast<size_t>(spec.numChannels), static_cast<size_t>(zldsp::maxChannelNum));
+        lanes.resize(static_cast<size_t>(spec.maximumBlockSize) * numLanes);
+        for (auto &f: toUpdates) {
+            f.store(true);
+        }
+        reset();
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::reset() {
+        for (auto &z: z1) {
+            z.fill(FloatType(0));
+        }
+        for (auto &z: z2) {
+            z.fill(FloatType(0));
+        }
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::process(juce::AudioBuffer<FloatType> &buffer) {
+        updateFilters();
+        if (std::none_of(actives.begin(), actives.end(), [](bool f) { return f; })) {
+            return;
+        }
+        const auto numChannels = juce::jmin(static_cast<size_t>(buffer.getNumChannels()), numLanes);
+        const auto numSamples = juce::jmin(static_cast<size_t>(buffer.getNumSamples()), lanes.size() / numLanes);
+        // interleave side channels
+        for (size_t i = 0; i < numChannels; ++i) {
+            const auto *src = buffer.getReadPointer(static_cast<int>(i));
+            for (size_t n = 0; n < numSamples; ++n) {
+                lanes[n * numChannels + i] = src[n];
+            }
+        }
+        // transposed direct form II biquads, each across all lanes
+        for (size_t idx = 0; idx < filterNUM; ++idx) {
+            if (!actives[idx]) {
+                continue;
+            }
+            const auto c = coeffs[idx];
+            auto &s1 = z1[idx], &s2 = z2[idx];
+            for (size_t n = 0; n < numSamples; ++n) {
+                auto *x = lanes.data() + n * numChannels;
+                for (size_t i = 0; i < numChannels; ++i) {
+                    const auto y = c.b0 * x[i] + s1[i];
+                    s1[i] = c.b1 * x[i] - c.a1 * y + s2[i];
+                    s2[i] = c.b2 * x[i] - c.a2 * y;
+                    x[i] = y;
+                }
+            }
+        }
+        // de-interleave side channels
+        for (size_t i = 0; i < numChannels; ++i) {
+            auto *dest = buffer.getWritePointer(static_cast<int>(i));
+            for (size_t n = 0; n < numSamples; ++n) {
+                dest[n] = lanes[n * numChannels + i];
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::setHPF(bool f) {
+        toActives[hpf].store(f);
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::setHPFFreq(FloatType v) {
+        hpfFreq.store(v);
+        markDirty(hpf);
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::setLPF(bool f) {
+        toActives[lpf].store(f);
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::setLPFFreq(FloatType v) {
+        lpfFreq.store(v);
+        markDirty(lpf);
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::setTilt(FloatType v) {
+        tiltGain.store(v);
+        toActives[tilt].store(std::abs(v) > FloatType(0.01));
+        markDirty(tilt);
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::setPeakFreq(FloatType v) {
+        peakFreq.store(v);
+        markDirty(peak);
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::setPeakGain(FloatType v) {
+        peakGain.store(v);
+        toActives[peak].store(std::abs(v) > FloatType(0.01));
+        markDirty(peak);
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::setPeakQ(FloatType v) {
+        peakQ.store(v);
+        markDirty(peak);
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::updateFilters() {
+        for (size_t idx = 0; idx < filterNUM; ++idx) {
+            if (toUpdates[idx].exchange(false)) {
+                updateCoeff(idx);
+            }
+            const auto f = toActives[idx].load();
+            if (f && !actives[idx]) {
+                z1[idx].fill(FloatType(0));
+                z2[idx].fill(FloatType(0));
+            }
+            actives[idx] = f;
+        }
+    }
+
+    template<typename FloatType>
+    void SideFilter<FloatType>::updateCoeff(size_t idx) {
+        // RBJ audio EQ cookbook
+        const auto freq = idx == hpf ? hpfFreq.load() :
+                          (idx == lpf ? lpfFreq.load() : (idx == tilt ? tiltFreq : peakFreq.load()));
+        const auto w0 = juce::MathConstants<double>::twoPi *
+                        juce::jlimit(1.0, fs * 0.49, static_cast<double>(freq)) / fs;
+        const auto cosW = std::cos(w0), sinW = std::sin(w0);
+        const auto butterworthQ = 1 / juce::MathConstants<double>::sqrt2;
+        double b0, b1, b2, a0, a1, a2;
+        switch (idx) {
+            case hpf: {
+                const auto alpha = sinW / (2 * butterworthQ);
+                b0 = (1 + cosW) / 2, b1 = -(1 + cosW), b2 = (1 + cosW) / 2;
+                a0 = 1 + alpha, a1 = -2 * cosW, a2 = 1 - alpha;
+                break;
+            }
+            case lpf: {
+                const auto alpha = sinW / (2 * butterworthQ);
+                b0 = (1 - cosW) / 2, b1 = 1 - cosW, b2 = (1 - cosW) / 2;
+                a0 = 1 + alpha, a1 = -2 * cosW, a2 = 1 - alpha;
+                break;
+            }
+            case tilt: {
+                // high shelf with half of the gain removed, so the tilt pivots around tiltFreq
+                const auto A = std::pow(10.0, static_cast<double>(tiltGain.load()) / 40);
+                const auto alpha = sinW / 2 * juce::MathConstants<double>::sqrt2;
+                const auto beta = 2 * std::sqrt(A) * alpha;
+                const auto scale = 1 / A;
+                b0 = scale * A * ((A + 1) + (A - 1) * cosW + beta);
+                b1 = scale * -2 * A * ((A - 1) + (A + 1) * cosW);
+                b2 = scale * A * ((A + 1) + (A - 1) * cosW - beta);
+                a0 = (A + 1) - (A - 1) * cosW + beta;
+                a1 = 2 * ((A - 1) - (A + 1) * cosW);
+                a2 = (A + 1) - (A - 1) * cosW - beta;
+                break;
+            }
+            case peak:
+            default: {
+                const auto A = std::pow(10.0, static_cast<double>(peakGain.load()) / 40);
+                const auto alpha = sinW / (2 * juce::jmax(static_cast<double>(peakQ.load()), 0.01));
+                b0 = 1 + alpha * A, b1 = -2 * cosW, b2 = 1 - alpha * A;
+                a0 = 1 + alpha / A, a1 = -2 * cosW, a2 = 1 - alpha / A;
+                break;
+            }
+        }
+        coeffs[idx] = {static_cast<FloatType>(b0 / a0), static_cast<FloatType>(b1 / a0),
+                       static_cast<FloatType>(b2 / a0), static_cast<FloatType>(a1 / a0),
+                       static_cast<FloatType>(a2 / a0)};
+    }
+
+    template
+    class SideFilter<float>;
+
+    template
+    class SideFilter<double>;
+} // zlfilter
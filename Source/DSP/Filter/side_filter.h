@@ -0,0 +1,87 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#ifndef ZLECOMP_SIDE_FILTER_H
+#define ZLECOMP_SIDE_FILTER_H
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include "../dsp_definitions.h"
+
+namespace zlfilter {
+
+    /**
+     * a chain of biquads (HPF, LPF, tilt, peak) for the side-chain
+     * the setters only store the parameters, dirty coefficients are recomputed on the audio thread in process()
+     * side channels are interleaved so that each biquad runs across all channels at once
+     */
+    template<typename FloatType>
+    class SideFilter {
+    public:
+        enum {
+            hpf, lpf, tilt, peak, filterNUM
+        };
+
+        SideFilter() = default;
+
+        void prepare(const juce::dsp::ProcessSpec &spec);
+
+        void reset();
+
+        void process(juce::AudioBuffer<FloatType> &buffer);
+
+        void setHPF(bool f);
+
+        void setHPFFreq(FloatType v);
+
+        void setLPF(bool f);
+
+        void setLPFFreq(FloatType v);
+
+        void setTilt(FloatType v);
+
+        void setPeakFreq(FloatType v);
+
+        void setPeakGain(FloatType v);
+
+        void setPeakQ(FloatType v);
+
+    private:
+        struct Coeff {
+            FloatType b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+        };
+
+        double fs = 44100;
+        size_t numLanes = 2;
+        std::vector<FloatType> lanes;
+
+        std::array<Coeff, filterNUM> coeffs;
+        std::array<bool, filterNUM> actives{};
+        std::array<std::atomic<bool>, filterNUM> toActives{}, toUpdates{};
+        std::array<std::array<FloatType, zldsp::maxChannelNum>, filterNUM> z1{}, z2{};
+
+        std::atomic<FloatType> hpfFreq = zldsp::sideHPFFreq::defaultV, lpfFreq = zldsp::sideLPFFreq::defaultV;
+        std::atomic<FloatType> tiltGain = zldsp::sideTilt::defaultV;
+        std::atomic<FloatType> peakFreq = zldsp::sidePeakFreq::defaultV, peakGain = zldsp::sidePeakGain::defaultV;
+        std::atomic<FloatType> peakQ = zldsp::sidePeakQ::defaultV;
+
+        // pivot frequency of the tilt filter
+        inline auto static constexpr tiltFreq = FloatType(1000);
+
+        void updateCoeff(size_t idx);
+
+        void updateFilters();
+
+        inline void markDirty(size_t idx) { toUpdates[idx].store(true); }
+    };
+
+} // zlfilter
+
+#endif //ZLECOMP_SIDE_FILTER_H
@@ -31,6 +31,13 @@ namespace fixedBuffer {
         buffer.setSize(channels, bufferSize + 1);
     }
 
+    template<typename FloatType>
+    void FIFOAudioBuffer<FloatType>::setSize(FloatType *const *channels, int numChannels, int bufferSize) {
+        fifo.setTotalSize(getStorageSize(bufferSize));
+        buffer.setDataToReferTo(channels, numChannels, getStorageSize(bufferSize));
+        clear();
+    }
+
     template<typename FloatType>
     void FIFOAudioBuffer<FloatType>::push(const FloatType **samples, int numSamples) {
         jassert (fifo.getFreeSpace() >= numSamples);
@@ -82,6 +89,20 @@ namespace fixedBuffer {
         fifo.finishedWrite(size1 + size2);
     }
 
+    template<typename FloatType>
+    void FIFOAudioBuffer<FloatType>::pushZeros(int numSamples) {
+        jassert (fifo.getFreeSpace() >= numSamples);
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+        if (size1 > 0)
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                buffer.clear(channel, start1, size1);
+        if (size2 > 0)
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                buffer.clear(channel, start2, size2);
+        fifo.finishedWrite(size1 + size2);
+    }
+
     template<typename FloatType>
     void FIFOAudioBuffer<FloatType>::pop(int numSamples) {
         jassert (fifo.getNumReady() >= numSamples);
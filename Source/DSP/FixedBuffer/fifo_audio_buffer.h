@@ -24,12 +24,21 @@ namespace fixedBuffer {
 
         void setSize(int channels, int bufferSize);
 
+        /**
+         * refer to external channels instead of allocating, each of them holds getStorageSize(bufferSize) samples
+         */
+        void setSize(FloatType *const *channels, int numChannels, int bufferSize);
+
+        static constexpr int getStorageSize(int bufferSize) { return bufferSize + 1; }
+
         void push(const FloatType **samples, int numSamples);
 
         void push(const juce::AudioBuffer<FloatType> &samples, int numSamples = -1);
 
         void push(juce::dsp::AudioBlock<FloatType> block, int numSamples = -1);
 
+        void pushZeros(int numSamples);
+
         void pop(int numSamples);
 
         void pop(FloatType **samples, int numSamples);
@@ -48,6 +57,11 @@ namespace fixedBuffer {
 
         inline auto isFull() const { return fifo.getFreeSpace() == 0; }
 
+        inline size_t getMemoryBytes() const {
+            return static_cast<size_t>(buffer.getNumChannels()) * static_cast<size_t>(buffer.getNumSamples()) *
+                   sizeof(FloatType);
+        }
+
     private:
         juce::AbstractFifo fifo;
 
@@ -11,6 +11,9 @@
 #include "fixed_audio_buffer.h"
 
 namespace fixedBuffer {
+    // the controller splits each main channel into a main and a side channel
+    constexpr auto maxChannelNum = static_cast<size_t>(zldsp::maxChannelNum) * 2;
+
     template<typename FloatType>
     FixedAudioBuffer<FloatType>::FixedAudioBuffer(int subBufferSize) :
             inputBuffer(2, 441), outputBuffer(2, 441),
@@ -27,29 +30,48 @@ namespace fixedBuffer {
     }
 
     template<typename FloatType>
-    void FixedAudioBuffer<FloatType>::setSubBufferSize(int subBufferSize) {
+    void FixedAudioBuffer<FloatType>::reset() {
         clear();
+        // put latency samples
+        const auto subBufferSize = subBuffer.getNumSamples();
+        if (subBufferSize > 1) {
+            inputBuffer.pushZeros(subBufferSize);
+        }
+    }
+
+    template<typename FloatType>
+    void FixedAudioBuffer<FloatType>::setSubBufferSize(int subBufferSize) {
         // init internal spec
         subSpec = mainSpec;
         subSpec.maximumBlockSize = static_cast<juce::uint32>(subBufferSize);
-        // resize subBuffer, inputBuffer and outputBuffer
-        subBuffer.setSize(static_cast<int>(subSpec.numChannels),
-                          static_cast<int>(subSpec.maximumBlockSize));
-        inputBuffer.setSize(static_cast<int>(mainSpec.numChannels),
-                            static_cast<int>(mainSpec.maximumBlockSize) + subBufferSize);
-        outputBuffer.setSize(static_cast<int>(mainSpec.numChannels),
-                             static_cast<int>(mainSpec.maximumBlockSize) + subBufferSize);
-        // put latency samples
-        if (subBufferSize > 1) {
-            juce::AudioBuffer<FloatType> zeroBuffer(inputBuffer.getNumChannels(), subBufferSize);
-            for (int channel = 0; channel < zeroBuffer.getNumChannels(); ++channel) {
-                auto *channelData = zeroBuffer.getWritePointer(channel);
-                for (int index = 0; index < subBufferSize; ++index) {
-                    channelData[index] = 0;
-                }
-            }
-            inputBuffer.push(zeroBuffer, subBufferSize);
+        // plan subBuffer, inputBuffer and outputBuffer, then carve them from one allocation
+        const auto subChannels = static_cast<size_t>(subSpec.numChannels);
+        const auto mainChannels = static_cast<size_t>(mainSpec.numChannels);
+        jassert(subChannels <= maxChannelNum && mainChannels <= maxChannelNum);
+        const auto fifoSize = static_cast<int>(mainSpec.maximumBlockSize) + subBufferSize;
+        const auto subStride = zlarena::Arena::getStride<FloatType>(static_cast<size_t>(subBufferSize));
+        const auto fifoStride = zlarena::Arena::getStride<FloatType>(
+                static_cast<size_t>(FIFOAudioBuffer<FloatType>::getStorageSize(fifoSize)));
+        arena.clear();
+        const auto subOffset = arena.add<FloatType>(subStride * subChannels);
+        const auto inputOffset = arena.add<FloatType>(fifoStride * mainChannels);
+        const auto outputOffset = arena.add<FloatType>(fifoStride * mainChannels);
+        arena.allocate();
+
+        std::array<FloatType *, maxChannelNum> channels{};
+        for (size_t i = 0; i < subChannels; ++i) {
+            channels[i] = arena.get<FloatType>(subOffset) + i * subStride;
+        }
+        subBuffer.setDataToReferTo(channels.data(), static_cast<int>(subChannels), subBufferSize);
+        for (size_t i = 0; i < mainChannels; ++i) {
+            channels[i] = arena.get<FloatType>(inputOffset) + i * fifoStride;
+        }
+        inputBuffer.setSize(channels.data(), static_cast<int>(mainChannels), fifoSize);
+        for (size_t i = 0; i < mainChannels; ++i) {
+            channels[i] = arena.get<FloatType>(outputOffset) + i * fifoStride;
         }
+        outputBuffer.setSize(channels.data(), static_cast<int>(mainChannels), fifoSize);
+        reset();
     }
 
     template<typename FloatType>
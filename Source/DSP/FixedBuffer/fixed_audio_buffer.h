@@ -14,6 +14,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "../dsp_definitions.h"
+#include "../Arena/arena.h"
 #include "fifo_audio_buffer.h"
 
 namespace fixedBuffer {
@@ -26,6 +27,15 @@ namespace fixedBuffer {
 
         void clear();
 
+        /**
+         * clear all buffers and put the latency samples back, it does not allocate
+         */
+        void reset();
+
+        /**
+         * carve the sub buffer and the FIFOs from the arena, call it off the audio thread
+         * the arena only grows, so a smaller size does not allocate
+         */
         void setSubBufferSize(int subBufferSize);
 
         void prepare(juce::dsp::ProcessSpec spec);
@@ -54,6 +64,8 @@ namespace fixedBuffer {
 
         inline auto getSubSpec() { return subSpec; }
 
+        inline size_t getMemoryBytes() const { return arena.getAllocatedBytes(); }
+
         inline juce::uint32 getLatencySamples() {
             if (subSpec.maximumBlockSize > 1) {
                 return subSpec.maximumBlockSize;
@@ -64,6 +76,8 @@ namespace fixedBuffer {
 
     private:
         FIFOAudioBuffer<FloatType> inputBuffer, outputBuffer;
+        // the sub buffer and the FIFOs refer to channels of the arena
+        zlarena::Arena arena;
         juce::dsp::ProcessSpec subSpec, mainSpec;
     };
 }
@@ -0,0 +1,58 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "gain_ramp.h"
+
+namespace zlgain {
+    template<typename FloatType>
+    void GainRamp<FloatType>::prepare(size_t segmentSize) {
+        ramp.resize(juce::jmax(size_t(1), segmentSize / 4));
+        tabulate();
+        reset();
+    }
+
+    template<typename FloatType>
+    void GainRamp<FloatType>::setShape(size_t idx) {
+        shape = idx;
+        tabulate();
+    }
+
+    template<typename FloatType>
+    void GainRamp<FloatType>::tabulate() {
+        const auto rampSize = static_cast<double>(ramp.size());
+        for (size_t n = 0; n < ramp.size(); ++n) {
+            const auto t = static_cast<double>(n + 1) / rampSize;
+            ramp[n] = static_cast<FloatType>(
+                    shape == linear ? t : 0.5 - 0.5 * std::cos(juce::MathConstants<double>::pi * t));
+        }
+    }
+
+    template<typename FloatType>
+    void GainRamp<FloatType>::process(FloatType *const *channels, const FloatType *gains,
+                                      size_t numChannels, size_t numSamples) {
+        if (toSnap) {
+            std::copy(gains, gains + numChannels, prevGains.begin());
+            toSnap = false;
+        }
+        const auto rampSize = juce::jmin(numSamples, ramp.size());
+        for (size_t i = 0; i < numChannels; ++i) {
+            auto *x = channels[i];
+            zlkernel::multiplyRamp(x, ramp.data(), prevGains[i], gains[i] - prevGains[i], rampSize);
+            zlkernel::multiply(x + rampSize, gains[i], numSamples - rampSize);
+            prevGains[i] = gains[i];
+        }
+    }
+
+    template
+    class GainRamp<float>;
+
+    template
+    class GainRamp<double>;
+} // zlgain
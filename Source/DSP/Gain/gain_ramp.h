@@ -0,0 +1,74 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#ifndef ZLECOMP_GAIN_RAMP_H
+#define ZLECOMP_GAIN_RAMP_H
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "../dsp_definitions.h"
+#include "../Kernel/simd_kernels.h"
+
+namespace zlgain {
+
+    /**
+     * apply per-channel gains to a segment, ramping from the gains of the previous segment
+     * the ramp shape is tabulated once per segment size, so each channel is a single multiply pass
+     */
+    template<typename FloatType>
+    class GainRamp {
+    public:
+        enum {
+            linear, cosine, shapeNUM
+        };
+
+        GainRamp() { prepare(1); }
+
+        /**
+         * tabulate the ramp, which allocates, do not call it on the audio thread
+         * @param segmentSize number of samples of each segment, the ramp covers the first quarter
+         */
+        void prepare(size_t segmentSize);
+
+        /**
+         * the next segment starts from its own gains without a ramp
+         */
+        inline void reset() { toSnap = true; }
+
+        void setShape(size_t idx);
+
+        /**
+         * @param n sample index in the segment
+         * @return the ramp position in (0, 1], 1 after the ramp
+         */
+        inline FloatType getPosition(size_t n) const {
+            return n < ramp.size() ? ramp[n] : FloatType(1);
+        }
+
+        /**
+         * multiply each channel with its gain, ramped from the gain of the previous segment
+         * @param channels write pointers of each channel
+         * @param gains the target gain of each channel
+         * @param numChannels number of channels, at most zldsp::maxChannelNum
+         * @param numSamples number of samples
+         */
+        void process(FloatType *const *channels, const FloatType *gains, size_t numChannels, size_t numSamples);
+
+    private:
+        std::vector<FloatType> ramp;
+        size_t shape = cosine;
+        bool toSnap = true;
+        std::array<FloatType, zldsp::maxChannelNum> prevGains{};
+
+        void tabulate();
+    };
+
+} // zlgain
+
+#endif //ZLECOMP_GAIN_RAMP_H
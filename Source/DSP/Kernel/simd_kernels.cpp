@@ -0,0 +1,201 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "simd_kernels.h"
+
+// wider levels are only compiled where the compiler can target them per function
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ZL_KERNEL_X86_TARGETS 1
+#define ZL_KERNEL_TARGET(isa) __attribute__((target(isa), flatten))
+#else
+#define ZL_KERNEL_X86_TARGETS 0
+#endif
+
+// never contract a multiply and an add into fma, which only some levels have, so that all levels are bit-identical
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace zlkernel {
+    namespace {
+        // number of independent accumulators, enough to fill the widest vector (16 floats)
+        constexpr size_t laneNum = 16;
+
+        template<typename AccType, typename FloatType>
+        inline AccType sumOfSquaresImpl(const FloatType *x, size_t num) {
+            std::array<AccType, laneNum> acc{};
+            size_t i = 0;
+            for (; i + laneNum <= num; i += laneNum) {
+                for (size_t j = 0; j < laneNum; ++j) {
+                    const auto v = static_cast<AccType>(x[i + j]);
+                    acc[j] += v * v;
+                }
+            }
+            for (size_t j = 0; i < num; ++i, ++j) {
+                const auto v = static_cast<AccType>(x[i]);
+                acc[j] += v * v;
+            }
+            // pairwise reduction in a fixed order
+            for (size_t width = laneNum / 2; width > 0; width /= 2) {
+                for (size_t j = 0; j < width; ++j) {
+                    acc[j] += acc[j + width];
+                }
+            }
+            return acc[0];
+        }
+
+        template<typename FloatType>
+        inline FloatType maximumImpl(const FloatType *x, size_t num) {
+            std::array<FloatType, laneNum> acc;
+            acc.fill(std::numeric_limits<FloatType>::lowest());
+            size_t i = 0;
+            for (; i + laneNum <= num; i += laneNum) {
+                for (size_t j = 0; j < laneNum; ++j) {
+                    acc[j] = x[i + j] > acc[j] ? x[i + j] : acc[j];
+                }
+            }
+            for (size_t j = 0; i < num; ++i, ++j) {
+                acc[j] = std::max(acc[j], x[i]);
+            }
+            return *std::max_element(acc.begin(), acc.end());
+        }
+
+        template<typename FloatType>
+        inline void multiplyRampImpl(FloatType *x, const FloatType *ramp, FloatType g0, FloatType dg, size_t num) {
+            for (size_t i = 0; i < num; ++i) {
+                const auto g = ramp[i] * dg;
+                x[i] *= g0 + g;
+            }
+        }
+
+        template<typename FloatType>
+        inline void multiplyImpl(FloatType *x, FloatType g, size_t num) {
+            for (size_t i = 0; i < num; ++i) {
+                x[i] *= g;
+            }
+        }
+
+        template<typename AccType, typename FloatType>
+        struct Table {
+            AccType (*sumOfSquares)(const FloatType *, size_t);
+            FloatType (*maximum)(const FloatType *, size_t);
+            void (*multiplyRamp)(FloatType *, const FloatType *, FloatType, FloatType, size_t);
+            void (*multiply)(FloatType *, FloatType, size_t);
+        };
+
+        // one set of entry points for each level, each compiled with its own target
+#define ZL_KERNEL_LEVEL(name, attribute)                                                                       \
+        template<typename AccType, typename FloatType>                                                         \
+        attribute AccType sumOfSquares##name(const FloatType *x, size_t num) {                                 \
+            return sumOfSquaresImpl<AccType>(x, num);                                                          \
+        }                                                                                                      \
+        template<typename FloatType>                                                                           \
+        attribute FloatType maximum##name(const FloatType *x, size_t num) {                                    \
+            return maximumImpl(x, num);                                                                        \
+        }                                                                                                      \
+        template<typename FloatType>                                                                           \
+        attribute void multiplyRamp##name(FloatType *x, const FloatType *ramp,                                 \
+                                          FloatType g0, FloatType dg, size_t num) {                            \
+            multiplyRampImpl(x, ramp, g0, dg, num);                                                            \
+        }                                                                                                      \
+        template<typename FloatType>                                                                           \
+        attribute void multiply##name(FloatType *x, FloatType g, size_t num) {                                 \
+            multiplyImpl(x, g, num);                                                                           \
+        }                                                                                                      \
+        template<typename AccType, typename FloatType>                                                         \
+        constexpr Table<AccType, FloatType> table##name{&sumOfSquares##name<AccType, FloatType>,               \
+                                                        &maximum##name<FloatType>,                             \
+                                                        &multiplyRamp##name<FloatType>,                        \
+                                                        &multiply##name<FloatType>};
+
+        ZL_KERNEL_LEVEL(Generic, )
+#if ZL_KERNEL_X86_TARGETS
+        ZL_KERNEL_LEVEL(AVX2, ZL_KERNEL_TARGET("avx2"))
+        ZL_KERNEL_LEVEL(AVX512, ZL_KERNEL_TARGET("avx512f"))
+#endif
+#undef ZL_KERNEL_LEVEL
+
+        template<typename AccType, typename FloatType>
+        constexpr std::array<Table<AccType, FloatType>, levelNUM> tables{
+#if ZL_KERNEL_X86_TARGETS
+                tableGeneric<AccType, FloatType>, tableAVX2<AccType, FloatType>, tableAVX512<AccType, FloatType>
+#else
+                tableGeneric<AccType, FloatType>, tableGeneric<AccType, FloatType>, tableGeneric<AccType, FloatType>
+#endif
+        };
+
+        Level detectLevel() {
+#if ZL_KERNEL_X86_TARGETS
+            if (juce::SystemStats::hasAVX512F()) {
+                return avx512;
+            }
+            if (juce::SystemStats::hasAVX2()) {
+                return avx2;
+            }
+#endif
+            return generic;
+        }
+
+        const Level supportedLevel = detectLevel();
+        std::atomic<Level> currentLevel{supportedLevel};
+    }
+
+    Level getSupportedLevel() {
+        return supportedLevel;
+    }
+
+    Level getLevel() {
+        return currentLevel.load(std::memory_order_relaxed);
+    }
+
+    void forceLevel(Level level) {
+        currentLevel.store(std::min(level, supportedLevel), std::memory_order_relaxed);
+    }
+
+    template<typename AccType, typename FloatType>
+    AccType sumOfSquares(const FloatType *x, size_t num) {
+        return tables<AccType, FloatType>[getLevel()].sumOfSquares(x, num);
+    }
+
+    template<typename FloatType>
+    FloatType maximum(const FloatType *x, size_t num) {
+        return tables<FloatType, FloatType>[getLevel()].maximum(x, num);
+    }
+
+    template<typename FloatType>
+    void multiplyRamp(FloatType *x, const FloatType *ramp, FloatType g0, FloatType dg, size_t num) {
+        tables<FloatType, FloatType>[getLevel()].multiplyRamp(x, ramp, g0, dg, num);
+    }
+
+    template<typename FloatType>
+    void multiply(FloatType *x, FloatType g, size_t num) {
+        tables<FloatType, FloatType>[getLevel()].multiply(x, g, num);
+    }
+
+    template float sumOfSquares<float, float>(const float *, size_t);
+
+    template double sumOfSquares<double, float>(const float *, size_t);
+
+    template double sumOfSquares<double, double>(const double *, size_t);
+
+    template float maximum<float>(const float *, size_t);
+
+    template double maximum<double>(const double *, size_t);
+
+    template void multiplyRamp<float>(float *, const float *, float, float, size_t);
+
+    template void multiplyRamp<double>(double *, const double *, double, double, size_t);
+
+    template void multiply<float>(float *, float, size_t);
+
+    template void multiply<double>(double *, double, size_t);
+} // zlkernel
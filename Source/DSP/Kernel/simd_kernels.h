@@ -0,0 +1,68 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#ifndef ZLECOMP_SIMD_KERNELS_H
+#define ZLECOMP_SIMD_KERNELS_H
+
+#include <juce_core/juce_core.h>
+
+namespace zlkernel {
+
+    /**
+     * instruction set levels of the kernels, each level is compiled from the same source with a different target
+     * every level accumulates in the same order without fused multiply-add, so all levels are bit-identical
+     */
+    enum Level {
+        generic, avx2, avx512, levelNUM
+    };
+
+    /**
+     * @return the highest level the current CPU (and the compiler) supports
+     */
+    Level getSupportedLevel();
+
+    /**
+     * @return the level the kernels currently run at
+     */
+    Level getLevel();
+
+    /**
+     * force the kernels to run at a level, e.g. to compare the results of different levels
+     * the level is clamped to the supported one, call it when no kernel is running
+     */
+    void forceLevel(Level level);
+
+    /**
+     * @return sum of x[i]^2, accumulated in AccType
+     */
+    template<typename AccType, typename FloatType>
+    AccType sumOfSquares(const FloatType *x, size_t num);
+
+    /**
+     * @return the maximum of x[i], or the lowest value of FloatType if num is zero
+     */
+    template<typename FloatType>
+    FloatType maximum(const FloatType *x, size_t num);
+
+    /**
+     * x[i] *= g0 + ramp[i] * dg
+     */
+    template<typename FloatType>
+    void multiplyRamp(FloatType *x, const FloatType *ramp, FloatType g0, FloatType dg, size_t num);
+
+    /**
+     * x[i] *= g
+     */
+    template<typename FloatType>
+    void multiply(FloatType *x, FloatType g, size_t num);
+
+} // zlkernel
+
+#endif //ZLECOMP_SIMD_KERNELS_H
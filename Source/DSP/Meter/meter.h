@@ -9,7 +9,10 @@
 #include <juce_dsp/juce_dsp.h>
 #include <boost/circular_buffer.hpp>
 
+#include "../FastMath/fast_db.h"
 #include "../FixedBuffer/fixed_audio_buffer.h"
+#include "../Kernel/simd_kernels.h"
+#include "../dsp_definitions.h"
 
 namespace zlmeter {
 
@@ -18,13 +21,23 @@ namespace zlmeter {
     public:
         auto static constexpr subBufferInSecond = 0.02;
 
+        // the values of each channel which are published to the editor
+        struct Snapshot {
+            std::array<FloatType, zldsp::maxChannelNum> rms{}, peak{}, peakMax{};
+            size_t numChannels = 0;
+        };
+
         explicit MeterSource(juce::AudioProcessor &processor) :
                 subBuffer() {
             processorRef = &processor;
+            for (auto *snapshot: {&snapshots[0], &snapshots[1], &snapshots[2], &writerState, &display}) {
+                snapshot->rms.fill(minusInfinityDB);
+                snapshot->peak.fill(minusInfinityDB);
+                snapshot->peakMax.fill(minusInfinityDB);
+            }
         }
 
         void reset() noexcept {
-            resetBuffer();
             resetPeakMax();
         }
 
@@ -33,50 +46,78 @@ namespace zlmeter {
             return s;
         }
 
-        void process(const juce::dsp::AudioBlock<FloatType> block) noexcept {
-            block.copyTo(m_buffer);
-            juce::dsp::AudioBlock<FloatType> m_block(m_buffer);
-            delayLine.process(juce::dsp::ProcessContextReplacing<FloatType>(m_block));
-            subBuffer.pushBlock(m_block);
+        /**
+         * the block should already be aligned, delays are handled by the latency graph of the controller
+         * blocks of another precision are converted to the display precision first
+         */
+        template<typename SampleType>
+        void process(const juce::dsp::AudioBlock<SampleType> block) noexcept {
+            if constexpr (std::is_same_v<SampleType, FloatType>) {
+                processBlock(block);
+            } else {
+                const auto numChannels = juce::jmin(block.getNumChannels(),
+                                                    static_cast<size_t>(convertBuffer.getNumChannels()));
+                const auto numSamples = juce::jmin(block.getNumSamples(),
+                                                   static_cast<size_t>(convertBuffer.getNumSamples()));
+                for (size_t i = 0; i < numChannels; ++i) {
+                    const auto *src = block.getChannelPointer(i);
+                    auto *dest = convertBuffer.getWritePointer(static_cast<int>(i));
+                    for (size_t n = 0; n < numSamples; ++n) {
+                        dest[n] = static_cast<FloatType>(src[n]);
+                    }
+                }
+                processBlock(juce::dsp::AudioBlock<FloatType>(convertBuffer).getSubBlock(0, numSamples));
+            }
+        }
+
+        void processBlock(const juce::dsp::AudioBlock<FloatType> block) noexcept {
+            subBuffer.pushBlock(block);
             while (subBuffer.isSubReady()) {
                 subBuffer.popSubBuffer();
                 const auto numSamples = static_cast<size_t>(subBuffer.subBuffer.getNumSamples());
-                const auto numChannels = static_cast<size_t>(subBuffer.subBuffer.getNumChannels());
+                const auto numChannels = juce::jmin(static_cast<size_t>(subBuffer.subBuffer.getNumChannels()),
+                                                    currentRMS.size());
+                // keep the maximum until the editor has taken the last published snapshot
+                const auto isConsumed = (sharedIdx.load(std::memory_order_acquire) & dirtyBit) == 0;
+                if (toResetPeakMax.exchange(false)) {
+                    writerState.peakMax.fill(minusInfinityDB);
+                }
                 for (size_t i = 0; i < numChannels; ++i) {
                     auto subBlock = juce::dsp::AudioBlock<FloatType>(subBuffer.subBuffer);
-                    currentRMS[i] = juce::Decibels::gainToDecibels(getRMSLevel(subBlock, i, 0, numSamples));
-                    currentPeak[i] = juce::Decibels::gainToDecibels(getPeakLevel(subBlock, i, 0, numSamples));
-                    bufferRMS[i] = juce::jmax(bufferRMS[i], currentRMS[i]);
-                    bufferPeak[i] = juce::jmax(bufferPeak[i], currentPeak[i]);
-                    peakMax[i] = juce::jmax(currentPeak[i], peakMax[i]);
+                    currentRMS[i] = zlmath::gainToDecibels(getRMSLevel(subBlock, i, 0, numSamples));
+                    currentPeak[i] = zlmath::gainToDecibels(getPeakLevel(subBlock, i, 0, numSamples));
+                    writerState.rms[i] = isConsumed ? currentRMS[i] : juce::jmax(writerState.rms[i], currentRMS[i]);
+                    writerState.peak[i] = isConsumed ? currentPeak[i] : juce::jmax(writerState.peak[i], currentPeak[i]);
+                    writerState.peakMax[i] = juce::jmax(currentPeak[i], writerState.peakMax[i]);
                 }
+                writerState.numChannels = numChannels;
+                publish();
                 historyRMS.push_back(std::accumulate(currentRMS.begin(), currentRMS.end(), FloatType(0)) /
                                      static_cast<FloatType>(currentRMS.size()));
                 historyPeak.push_back(std::accumulate(currentPeak.begin(), currentPeak.end(), FloatType(0)) /
                                       static_cast<FloatType>(currentPeak.size()));
                 subBuffer.pushSubBuffer();
             }
-            subBuffer.popBlock(m_block, false);
+            subBuffer.popBlock(block, false);
         }
 
         void prepare(const juce::dsp::ProcessSpec &spec) {
             historyRMS.set_capacity(static_cast<size_t>(spec.sampleRate * subBufferInSecond * 10));
             historyPeak.set_capacity(static_cast<size_t>(spec.sampleRate * subBufferInSecond * 10));
-            for (auto f: {&currentRMS, &currentPeak, &peakMax, &bufferRMS, &bufferPeak, &displayRMS, &displayPeak}) {
-                (*f).resize(spec.numChannels);
+            const auto numChannels = juce::jmin(static_cast<size_t>(spec.numChannels),
+                                                static_cast<size_t>(zldsp::maxChannelNum));
+            for (auto f: {&currentRMS, &currentPeak}) {
+                (*f).resize(numChannels);
             }
+            writerState = Snapshot();
+            writerState.rms.fill(minusInfinityDB);
+            writerState.peak.fill(minusInfinityDB);
+            writerState.peakMax.fill(minusInfinityDB);
             resetPeakMax();
-            resetBuffer();
-            for (size_t i = 0; i < displayRMS.size(); ++i) {
-                displayRMS[i] = static_cast<FloatType>(-100);
-                displayPeak[i] = static_cast<FloatType>(-100);
-            }
 
-            m_buffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+            convertBuffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
             subBuffer.prepare(spec);
             subBuffer.setSubBufferSize(static_cast<int>(spec.sampleRate * subBufferInSecond));
-            delayLine.prepare(spec);
-            delayLine.setMaximumDelayInSamples(static_cast<int>(spec.sampleRate) * 2);
         }
 
         size_t appendHistoryRMS(boost::circular_buffer<FloatType> &buffer,
@@ -119,50 +160,30 @@ namespace zlmeter {
                    static_cast<FloatType>(currentPeak.size());
         }
 
-        inline FloatType getBufferMeanRMS() {
-            return std::accumulate(std::begin(bufferRMS), std::end(bufferRMS), FloatType(0)) /
-                   static_cast<FloatType>(bufferRMS.size());
-        }
-
-        inline std::vector<FloatType> getBufferRMS() {
-            return bufferRMS;
-        }
-
-        inline std::vector<FloatType> getBufferPeak() {
-            return bufferPeak;
-        }
-
-        std::vector<FloatType> getDisplayRMS() {
-            for (size_t i = 0; i < displayRMS.size(); ++i) {
-                displayRMS[i] = juce::jmax(displayRMS[i] - static_cast<FloatType>(decayRate), bufferRMS[i]);
+        /**
+         * read the display values, the decay (in dB) is applied on each read
+         * it does not lock or allocate, and it should only be called from one (the message) thread
+         */
+        const Snapshot &readDisplay(FloatType decay) noexcept {
+            const Snapshot *latest = nullptr;
+            if (sharedIdx.load(std::memory_order_relaxed) & dirtyBit) {
+                readerIdx = sharedIdx.exchange(readerIdx, std::memory_order_acq_rel) & indexMask;
+                latest = &snapshots[readerIdx];
             }
-            return displayRMS;
-        }
-
-        std::vector<FloatType> getDisplayPeak() {
-            for (size_t i = 0; i < displayPeak.size(); ++i) {
-                displayPeak[i] = juce::jmax(displayPeak[i] - static_cast<FloatType>(decayRate), bufferPeak[i]);
-            }
-            return displayPeak;
-        }
-
-        std::vector<FloatType> getPeakMax() {
-            return peakMax;
-        }
-
-        void resetBuffer() {
-            const juce::GenericScopedLock<juce::CriticalSection> processLock(processorRef->getCallbackLock());
-            for (size_t i = 0; i < bufferRMS.size(); ++i) {
-                bufferRMS[i] = static_cast<FloatType>(-100);
-                bufferPeak[i] = static_cast<FloatType>(-100);
+            const auto &published = snapshots[readerIdx];
+            display.numChannels = published.numChannels;
+            for (size_t i = 0; i < display.numChannels; ++i) {
+                const auto rms = latest ? latest->rms[i] : minusInfinityDB;
+                const auto peak = latest ? latest->peak[i] : minusInfinityDB;
+                display.rms[i] = juce::jmax(display.rms[i] - decay, rms);
+                display.peak[i] = juce::jmax(display.peak[i] - decay, peak);
+                display.peakMax[i] = published.peakMax[i];
             }
+            return display;
         }
 
         void resetPeakMax() {
-            const juce::GenericScopedLock<juce::CriticalSection> processLock(processorRef->getCallbackLock());
-            for (size_t i = 0; i < peakMax.size(); ++i) {
-                peakMax[i] = static_cast<FloatType>(-100);
-            }
+            toResetPeakMax.store(true);
         }
 
         void resetHistory() {
@@ -171,27 +192,40 @@ namespace zlmeter {
             historyPeak.clear();
         }
 
-        void setDecayRate(float x) {
-            decayRate = x;
+        size_t getHistoryBytes() const {
+            return (historyRMS.capacity() + historyPeak.capacity()) * sizeof(FloatType);
         }
 
-        void setDelay(int numSamples) {
-            delayLine.setDelay(static_cast<float>(numSamples));
-            delayLine.reset();
+        size_t getFIFOBytes() const {
+            return subBuffer.getMemoryBytes() + static_cast<size_t>(convertBuffer.getNumChannels()) *
+                                                static_cast<size_t>(convertBuffer.getNumSamples()) * sizeof(FloatType);
         }
 
     private:
-        std::vector<FloatType> peakMax;
+        inline auto static constexpr minusInfinityDB = FloatType(-100);
         std::vector<FloatType> currentRMS, currentPeak;
-        std::vector<FloatType> bufferRMS, bufferPeak;
-        std::vector<FloatType> displayRMS, displayPeak;
+        // triple buffer: the audio thread writes into the back slot and swaps it with the shared slot
+        // the editor swaps the shared slot with its own slot when the dirty bit is set
+        inline auto static constexpr dirtyBit = 4, indexMask = 3;
+        std::array<Snapshot, 3> snapshots;
+        std::atomic<int> sharedIdx{1};
+        int writerIdx = 0, readerIdx = 2;
+        Snapshot writerState;
+        std::atomic<bool> toResetPeakMax{false};
+        // display values, only touched by the editor
+        Snapshot display;
+
+        void publish() noexcept {
+            snapshots[static_cast<size_t>(writerIdx)] = writerState;
+            const auto old = sharedIdx.exchange(writerIdx | dirtyBit, std::memory_order_acq_rel);
+            writerIdx = old & indexMask;
+        }
+
         boost::circular_buffer<FloatType> historyRMS, historyPeak;
         juce::AudioProcessor *processorRef;
-        float decayRate = 0.12f;
         bool useSubBuffer = false;
         fixedBuffer::FixedAudioBuffer<FloatType> subBuffer;
-        juce::AudioBuffer<FloatType> m_buffer;
-        juce::dsp::DelayLine<FloatType> delayLine;
+        juce::AudioBuffer<FloatType> convertBuffer;
 
         template<typename T>
         T getRMSLevel(juce::dsp::AudioBlock<T> block, size_t channel, size_t startSample,
@@ -200,12 +234,7 @@ namespace zlmeter {
                 return FloatType(0);
 
             auto *data = block.getChannelPointer(channel) + startSample;
-            double sum = 0.0;
-
-            for (size_t i = 0; i < numSamples; ++i) {
-                auto sample = static_cast<double>(data[i]);
-                sum += sample * sample;
-            }
+            const auto sum = zlkernel::sumOfSquares<double>(data, numSamples);
             return static_cast<FloatType>(std::sqrt(sum / static_cast<double>(numSamples)));
         }
 
@@ -216,14 +245,7 @@ namespace zlmeter {
                 return FloatType(0);
 
             auto *data = block.getChannelPointer(channel) + startSample;
-            FloatType localPeak = -1000.0;
-
-            for (size_t i = 0; i < numSamples; ++i) {
-                if (data[i] > localPeak) {
-                    localPeak = static_cast<FloatType>(data[i]);
-                }
-            }
-            return localPeak;
+            return static_cast<FloatType>(zlkernel::maximum(data, numSamples));
         }
     };
 }
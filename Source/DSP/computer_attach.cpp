@@ -14,11 +14,28 @@ namespace zlcontroller {
     template<typename FloatType>
     ComputerAttach<FloatType>::ComputerAttach(juce::AudioProcessor &processor,
                                               Controller<FloatType> &control,
-                                              juce::AudioProcessorValueTreeState &parameters) {
+                                              juce::AudioProcessorValueTreeState &parameters,
+                                              juce::AudioProcessorValueTreeState &state_parameters,
+                                              Dispatcher &dispatcher) {
         processorRef = &processor;
         c = &control;
         apvts = &parameters;
+        apvtsNA = &state_parameters;
+        for (size_t slot = 0; slot < slotIDs.size(); ++slot) {
+            for (size_t idx = 0; idx < slotIDs[slot].size(); ++idx) {
+                slotIDs[slot][idx] = zldsp::morphSlot::getID(slot, idx);
+            }
+        }
+        for (size_t band = 1; band < zldsp::maxBandNum; ++band) {
+            for (size_t idx = 0; idx < bandIDs[band - 1].size(); ++idx) {
+                bandIDs[band - 1][idx] = zldsp::bandParameters::getID(band, idx);
+            }
+        }
         isPlotReady.setValue(false);
+        dispatcherRef = &dispatcher;
+        plotTask = dispatcher.addTask([this]() { isPlotReady.setValue(!isPlotReady.getValue()); });
+        // the morph rebuilds the curves on the audio thread
+        c->setMorphTask(dispatcher, plotTask);
     }
 
     template<typename FloatType>
@@ -26,6 +43,19 @@ namespace zlcontroller {
         for (auto &ID: IDs) {
             apvts->removeParameterListener(ID, this);
         }
+        for (auto &ID: morphIDs) {
+            apvts->removeParameterListener(ID, this);
+        }
+        for (auto &ids: slotIDs) {
+            for (auto &ID: ids) {
+                apvtsNA->removeParameterListener(ID, this);
+            }
+        }
+        for (auto &ids: bandIDs) {
+            for (auto &ID: ids) {
+                apvts->removeParameterListener(ID, this);
+            }
+        }
     }
 
     template<typename FloatType>
@@ -33,6 +63,19 @@ namespace zlcontroller {
         for (size_t i = 0; i < IDs.size(); ++i) {
             parameterChanged(IDs[i], defaultVs[i]);
         }
+        for (size_t i = 0; i < morphIDs.size(); ++i) {
+            parameterChanged(morphIDs[i], morphDefaultVs[i]);
+        }
+        for (auto &ids: slotIDs) {
+            for (size_t i = 0; i < ids.size(); ++i) {
+                parameterChanged(ids[i], zldsp::morphSlot::defaultVs[i]);
+            }
+        }
+        for (auto &ids: bandIDs) {
+            for (size_t i = 0; i < ids.size(); ++i) {
+                parameterChanged(ids[i], zldsp::bandParameters::defaultVs[i]);
+            }
+        }
     }
 
     template<typename FloatType>
@@ -40,34 +83,110 @@ namespace zlcontroller {
         for (auto &ID: IDs) {
             apvts->addParameterListener(ID, this);
         }
+        for (auto &ID: morphIDs) {
+            apvts->addParameterListener(ID, this);
+        }
+        for (auto &ids: slotIDs) {
+            for (auto &ID: ids) {
+                apvtsNA->addParameterListener(ID, this);
+            }
+        }
+        for (auto &ids: bandIDs) {
+            for (auto &ID: ids) {
+                apvts->addParameterListener(ID, this);
+            }
+        }
     }
 
     template<typename FloatType>
     void ComputerAttach<FloatType>::parameterChanged(const juce::String &parameterID, float newValue) {
         auto v = static_cast<FloatType>(newValue);
-        if (parameterID == zldsp::threshold::ID) {
-            const juce::GenericScopedLock<juce::CriticalSection> processLock(processorRef->getCallbackLock());
-            c->lrComputer.setThreshold(v);
-        } else if (parameterID == zldsp::ratio::ID) {
-            c->lrComputer.setRatio(v);
-        } else if (parameterID == zldsp::kneeW::ID) {
-            const juce::GenericScopedLock<juce::CriticalSection> processLock(processorRef->getCallbackLock());
-            c->lrComputer.setKneeW(zldsp::kneeW::formatV(v));
-        } else if (parameterID == zldsp::kneeS::ID) {
-            c->lrComputer.setKneeS(v);
-        } else if (parameterID == zldsp::kneeD::ID) {
-            c->lrComputer.setKneeD(v);
-        } else if (parameterID == zldsp::bound::ID) {
-            c->lrComputer.setBound(v);
-        }
-        isPlotReady.setValue(!isPlotReady.getValue());
+        if (parameterID == zldsp::morphOn::ID) {
+            c->setMorphOn(newValue > .5f);
+            if (newValue <= .5f) {
+                applyCurrentParameters();
+            }
+        } else if (parameterID == zldsp::morph::ID) {
+            c->setMorph(v);
+        } else if (parameterID.startsWith("morph")) {
+            for (size_t slot = 0; slot < slotIDs.size(); ++slot) {
+                for (size_t idx = 0; idx < slotIDs[slot].size(); ++idx) {
+                    if (parameterID == slotIDs[slot][idx]) {
+                        c->setMorphSlot(slot, idx, v);
+                    }
+                }
+            }
+        } else if (parameterID.startsWith("band")) {
+            for (size_t band = 1; band < zldsp::maxBandNum; ++band) {
+                for (size_t idx = 0; idx < bandIDs[band - 1].size(); ++idx) {
+                    if (parameterID == bandIDs[band - 1][idx]) {
+                        setComputerParameter(band, idx, v);
+                    }
+                }
+            }
+        } else if (c->getMorphOn()) {
+            // the computer of the first band is driven by the morph slots
+        } else {
+            for (size_t idx = 0; idx < IDs.size(); ++idx) {
+                if (parameterID == IDs[idx]) {
+                    setComputerParameter(0, idx, v);
+                }
+            }
+        }
+        dispatcherRef->post(plotTask);
+    }
+
+    template<typename FloatType>
+    void ComputerAttach<FloatType>::storeMorphSlot(size_t slot) {
+        for (size_t idx = 0; idx < IDs.size(); ++idx) {
+            auto *para = apvtsNA->getParameter(slotIDs[slot][idx]);
+            para->beginChangeGesture();
+            para->setValueNotifyingHost(para->convertTo0to1(apvts->getRawParameterValue(IDs[idx])->load()));
+            para->endChangeGesture();
+        }
+    }
+
+    template<typename FloatType>
+    void ComputerAttach<FloatType>::applyCurrentParameters() {
+        for (auto &ID: IDs) {
+            parameterChanged(ID, apvts->getRawParameterValue(ID)->load());
+        }
+    }
+
+    template<typename FloatType>
+    void ComputerAttach<FloatType>::setComputerParameter(size_t band, size_t idx, FloatType v) {
+        auto &computer = c->computers[band];
+        switch (idx) {
+            case zldsp::bandParameters::thresholdIdx:
+                computer.setThreshold(v);
+                break;
+            case zldsp::bandParameters::ratioIdx:
+                computer.setRatio(v);
+                break;
+            case zldsp::bandParameters::kneeWIdx:
+                computer.setKneeW(zldsp::kneeW::formatV(v));
+                break;
+            case zldsp::bandParameters::kneeDIdx:
+                computer.setKneeD(v);
+                break;
+            case zldsp::bandParameters::kneeSIdx:
+                computer.setKneeS(v);
+                break;
+            case zldsp::bandParameters::boundIdx:
+                computer.setBound(v);
+                break;
+            default:
+                break;
+        }
     }
 
     template<typename FloatType>
     void ComputerAttach<FloatType>::getPlotArray(std::vector<float> &x, std::vector<float> &y){
+        // evaluate a local copy, so that the message thread never rebuilds the curve of the audio thread
+        auto computer = zlcomputer::Computer<FloatType>(c->computers[0]);
         for (size_t i = 0; i < 121; ++i) {
             x.push_back((static_cast<float>(i) - 120.f) * 0.5f);
-            y.push_back(static_cast<float>(c->lrComputer.eval(x[i])));
+            y.push_back(static_cast<float>(computer.eval(x[i])));
         }
     }
 
@@ -15,6 +15,7 @@
 #include <juce_dsp/juce_dsp.h>
 #include "dsp_definitions.h"
 #include "controller.h"
+#include "dispatcher.h"
 
 namespace zlcontroller {
     template<typename FloatType>
@@ -25,7 +26,9 @@ namespace zlcontroller {
 
         explicit ComputerAttach(juce::AudioProcessor &processor,
                                 Controller<FloatType> &control,
-                                juce::AudioProcessorValueTreeState &parameters);
+                                juce::AudioProcessorValueTreeState &parameters,
+                                juce::AudioProcessorValueTreeState &state_parameters,
+                                Dispatcher &dispatcher);
 
         ~ComputerAttach() override;
 
@@ -37,12 +40,23 @@ namespace zlcontroller {
 
         void getPlotArray(std::vector<float> &x, std::vector<float> &y);
 
-        FloatType getThreshold() { return c->lrComputer.getThreshold(); }
+        FloatType getThreshold() { return c->computers[0].getThreshold(); }
+
+        /**
+         * store the current computer parameters into a morph slot
+         */
+        void storeMorphSlot(size_t slot);
 
     private:
         juce::AudioProcessor *processorRef;
         Controller<FloatType> *c;
-        juce::AudioProcessorValueTreeState *apvts;
+        juce::AudioProcessorValueTreeState *apvts, *apvtsNA;
+        // the plot is invalidated on the message thread
+        Dispatcher *dispatcherRef;
+        size_t plotTask;
+        std::array<std::array<juce::String, zldsp::morphSlot::paraNUM>, zldsp::maxMorphSlotNum> slotIDs;
+        // the global parameters drive the first band, each later band has its own parameters
+        std::array<std::array<juce::String, zldsp::bandParameters::computerParaNUM>, zldsp::maxBandNum - 1> bandIDs;
         constexpr const static std::array IDs{zldsp::threshold::ID, zldsp::ratio::ID,
                                               zldsp::kneeW::ID, zldsp::kneeD::ID,
                                               zldsp::kneeS::ID, zldsp::bound::ID};
@@ -50,6 +64,14 @@ namespace zlcontroller {
         constexpr const static std::array defaultVs{zldsp::threshold::defaultV, zldsp::ratio::defaultV,
                                                     zldsp::kneeW::defaultV, zldsp::kneeD::defaultV,
                                                     zldsp::kneeS::defaultV, zldsp::bound::defaultV};
+
+        constexpr const static std::array morphIDs{zldsp::morphOn::ID, zldsp::morph::ID};
+
+        constexpr const static std::array morphDefaultVs{float(zldsp::morphOn::defaultV), zldsp::morph::defaultV};
+
+        void applyCurrentParameters();
+
+        void setComputerParameter(size_t band, size_t idx, FloatType v);
     };
 }
 
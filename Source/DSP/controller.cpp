@@ -11,14 +11,56 @@
 #include "controller.h"
 
 namespace zlcontroller {
+    static_assert(alignof(Controller<float>) == zldsp::cacheLineSize && alignof(Controller<double>) == zldsp::cacheLineSize,
+                  "parameters and states of the controller should start on their own cache lines");
+
+    static juce::AudioChannelSet::ChannelType getPairedChannelType(juce::AudioChannelSet::ChannelType type) {
+        using cs = juce::AudioChannelSet;
+        constexpr std::array<std::pair<cs::ChannelType, cs::ChannelType>, 9> pairs{{
+                {cs::left, cs::right},
+                {cs::leftCentre, cs::rightCentre},
+                {cs::leftSurround, cs::rightSurround},
+                {cs::leftSurroundSide, cs::rightSurroundSide},
+                {cs::leftSurroundRear, cs::rightSurroundRear},
+                {cs::wideLeft, cs::wideRight},
+                {cs::topFrontLeft, cs::topFrontRight},
+                {cs::topSideLeft, cs::topSideRight},
+                {cs::topRearLeft, cs::topRearRight}
+        }};
+        for (const auto &pair: pairs) {
+            if (pair.first == type) {
+                return pair.second;
+            } else if (pair.second == type) {
+                return pair.first;
+            }
+        }
+        return cs::unknown;
+    }
+
+    // write (l + r) * scale and (l - r) * scale, encodes mid/side with 0.5 and decodes with 1
+    template<typename FloatType>
+    static void sumDifference(const FloatType *l, const FloatType *r, FloatType *m, FloatType *s,
+                              int numSamples, FloatType scale) {
+        for (int n = 0; n < numSamples; ++n) {
+            const auto sum = (l[n] + r[n]) * scale, diff = (l[n] - r[n]) * scale;
+            m[n] = sum;
+            s[n] = diff;
+        }
+    }
+
     template<typename FloatType>
     Controller<FloatType>::Controller(juce::AudioProcessor &processor,
                                       juce::AudioProcessorValueTreeState &parameters) :
             meterIn(processor), meterOut(processor), meterEnd(processor) {
         m_processor = &processor;
         apvts = &parameters;
-        mainDelay.setMaximumDelayInSamples(96000);
-        mixer.setWetMixProportion(zldsp::mix::formatV(zldsp::mix::defaultV));
+        mixProportion.store(zldsp::mix::formatV(zldsp::mix::defaultV));
+        setSilenceFloor(zldsp::silenceFloor::defaultV);
+        for (auto &slot: morphSlots) {
+            for (size_t idx = 0; idx < slot.size(); ++idx) {
+                slot[idx].store(zldsp::morphSlot::defaultVs[idx]);
+            }
+        }
     }
 
     template<typename FloatType>
@@ -26,22 +68,59 @@ namespace zlcontroller {
         reset();
     }
 
+    template<typename FloatType>
+    Footprint Controller<FloatType>::getFootprint() const {
+        Footprint footprint;
+        // juce::dsp::Oversampling does not report its memory, estimate it from the buffer of each 2x stage
+        const auto frameBytes = static_cast<size_t>(mainSpec.maximumBlockSize) * preparedOverSampleChannels *
+                                sizeof(FloatType);
+        for (const auto &overSampler: overSamplers) {
+            if (overSampler) {
+                footprint.bytes[Footprint::overSamplers] +=
+                        (2 * overSampler->getOversamplingFactor() - 2) * frameBytes;
+            }
+        }
+        footprint.bytes[Footprint::delayLines] = latencyGraph.getMemoryBytes();
+        footprint.bytes[Footprint::fifos] = subBuffer.getMemoryBytes();
+        for (const auto *meter: {&meterIn, &meterOut, &meterEnd}) {
+            footprint.bytes[Footprint::fifos] += meter->getFIFOBytes();
+            footprint.bytes[Footprint::meterHistories] += meter->getHistoryBytes();
+        }
+        for (const auto &hold: holds) {
+            footprint.bytes[Footprint::holds] += hold.getMemoryBytes();
+        }
+        // the delay buffer and the holds are carved from the same arena as the block buffers
+        footprint.bytes[Footprint::blockBuffers] = arena.getAllocatedBytes() - latencyGraph.getMemoryBytes() -
+                                                   footprint.bytes[Footprint::holds];
+        footprint.bytes[Footprint::bandBuffers] = bandArena.getAllocatedBytes();
+        return footprint;
+    }
+
     template<typename FloatType>
     void Controller<FloatType>::prepare(const juce::dsp::ProcessSpec spec) {
+        // all stored settings are applied below
+        toApply.store(0);
         mainSpec = {spec.sampleRate, spec.maximumBlockSize, spec.numChannels};
+        numChannels = juce::jmin(static_cast<size_t>(spec.numChannels), static_cast<size_t>(zldsp::maxChannelNum));
+        toSetLinkGroupID(linkGroupID.load());
+        // the filter design only depends on the number of channels, keep it across prepare calls
+        const auto overSampleChannels = static_cast<size_t>(spec.numChannels) * 2;
         for (size_t i = 0; i < zldsp::overSample::overSampleNUM; ++i) {
-            overSamplers[i] = std::make_unique<juce::dsp::Oversampling<FloatType>>(
-                    spec.numChannels * 2, i,
-                    juce::dsp::Oversampling<FloatType>::filterHalfBandFIREquiripple,
-                    true, true);
+            if (!overSamplers[i] || overSampleChannels != preparedOverSampleChannels) {
+                overSamplers[i] = std::make_unique<juce::dsp::Oversampling<FloatType>>(
+                        overSampleChannels, i,
+                        juce::dsp::Oversampling<FloatType>::filterHalfBandFIREquiripple,
+                        true, true);
+            }
             overSamplers[i]->initProcessing(spec.maximumBlockSize);
         }
-        mixer.prepare(spec);
-
-        mainDelay.prepare(spec);
-        mainDelay.setMaximumDelayInSamples(static_cast<int>(spec.sampleRate));
-        dryDelay.prepare(spec);
-        dryDelay.setMaximumDelayInSamples(static_cast<int>(spec.sampleRate));
+        preparedOverSampleChannels = overSampleChannels;
+        wetMix.reset(spec.sampleRate, 0.05);
+        wetMix.setCurrentAndTargetValue(mixProportion.load());
+        fadeLength = juce::jmax(1, static_cast<int>(spec.sampleRate * 0.01));
+        bypassState = byPass.load() ? bypassed : active;
+        fadePos = byPass.load() ? 0 : fadeLength;
+        sideFilter.prepare(spec);
         sideGainDSP.prepare(spec);
         sideGainDSP.setRampDurationSeconds(0.1);
         outGainDSP.prepare(spec);
@@ -50,82 +129,350 @@ namespace zlcontroller {
         meterOut.prepare(spec);
         meterEnd.prepare(spec);
 
-        allBuffer.setSize(static_cast<int>(spec.numChannels * 2), static_cast<int>(spec.maximumBlockSize));
-        dryBuffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+        // the longest tap is the largest lookahead plus the largest segment plus the over-sampling latency
+        const auto maxDelay = spec.sampleRate * (zldsp::lookahead::formatV(zldsp::lookahead::range.end) +
+                                                 zldsp::segment::formatV(zldsp::segment::range.end));
+        allocateBuffers(static_cast<size_t>(spec.maximumBlockSize), static_cast<int>(maxDelay) + 4096);
+        crossover.setBandNum(zldsp::bandNum::getBandNum(bandIdx.load()));
+        toSetStructureStyleID(structureStyle.load());
         reset();
-        setOversampleID(idxSampler.load(), false);
+        toSetOversampleID(idxSampler.load());
+        isPrepared.store(true);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::release() {
+        isPrepared.store(false);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::applyPendingChanges() {
+        if (!isPrepared.load()) {
+            return;
+        }
+        const auto changes = toApply.exchange(0);
+        if (changes == 0) {
+            return;
+        }
+        const juce::GenericScopedLock<juce::CriticalSection> processLock(m_processor->getCallbackLock());
+        if (changes & bandNumChange) {
+            toSetBandNum(bandIdx.load());
+        }
+        if (changes & linkGroupChange) {
+            toSetLinkGroupID(linkGroupID.load());
+        }
+        if (changes & styleChange) {
+            toSetStructureStyleID(structureStyle.load());
+        }
+        // over-sampling re-applies the segment, and the segment re-applies the rms size and the hold
+        if (changes & samplerChange) {
+            toSetOversampleID(idxSampler.load());
+        } else if (changes & segmentChange) {
+            toSetSegment(segment.load());
+        } else {
+            if (changes & rmsChange) {
+                toSetRMSSize(rmsSize.load());
+            }
+            if (changes & lookaheadChange) {
+                updateHoldSize();
+            }
+        }
+        setLatency();
     }
 
     template<typename FloatType>
     void Controller<FloatType>::reset() {
-        subBuffer.clear();
-        lDetector.reset();
-        rDetector.reset();
-        lTracker.reset();
-        rTracker.reset();
+        subBuffer.reset();
+        resetBands();
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::resetBands() {
+        crossover.reset();
+        for (auto &detector: detectors) {
+            detector.reset();
+        }
+        for (auto &hold: holds) {
+            hold.reset();
+        }
+        for (auto &bandTrackers: trackers) {
+            for (auto &tracker: bandTrackers) {
+                tracker.reset();
+            }
+        }
+        for (auto &gains: prevBandGains) {
+            gains.fill(FloatType(1));
+        }
     }
 
     template<typename FloatType>
     void Controller<FloatType>::process(juce::AudioBuffer<FloatType> &buffer) {
-        // copy buffer into allBuffer
-        allBuffer.makeCopyOf(buffer, true);
-        // copy side-chain into sideBuffer
+        const auto numSamples = buffer.getNumSamples();
+        // push the input into the shared delay and keep a latency-matched copy for bypass
+        const auto inBus = m_processor->getBusBuffer(buffer, true, 0);
+        latencyGraph.push(inBus);
+        referBuffers(numSamples);
+        latencyGraph.read(zldelay::LatencyGraph<FloatType>::bypassTap, bypassBuffer);
+        updateBypassState();
+        updateMorph();
+        for (auto &computer: computers) {
+            computer.update();
+        }
+        if (bypassState == bypassed) {
+            m_processor->getBusBuffer(buffer, false, 0).makeCopyOf(bypassBuffer, true);
+            return;
+        }
+        // check whether main and side-chain inputs are below the silence floor
+        const auto floor = silenceFloor.load();
+        const auto isSilent = inBus.getMagnitude(0, numSamples) <= floor &&
+                              (!external.load() ||
+                               m_processor->getBusBuffer(buffer, true, 1).getMagnitude(0, numSamples) <= floor);
+        if (isSilent) {
+            silentSamples = juce::jmin(silentSamples + numSamples, std::numeric_limits<int>::max() / 2);
+        } else {
+            silentSamples = 0;
+            isIdle = false;
+        }
+        // wait until the delayed signal and the rms window have been flushed
+        const auto holdSamples = latencySamples + static_cast<int>(rmsSize.load() * mainSpec.sampleRate);
+        if (bypassState == active && silentSamples > holdSamples) {
+            processIdle(buffer);
+            return;
+        }
+        // copy side-chain into sideBuffer and the lookahead tap into mainBuffer
+        // encode stereo to mid/side on the way
+        const auto isMidSide = midSide.load() && numChannels == 2;
+        juce::AudioBuffer<FloatType> mainBuffer(m_processor->getBusBuffer(allBuffer, true, 0));
         juce::AudioBuffer<FloatType> sideBuffer(m_processor->getBusBuffer(allBuffer, true, 1));
-        if (!external.load()) {
-            sideBuffer.makeCopyOf(m_processor->getBusBuffer(buffer, true, 0), true);
+        const auto sideSource = m_processor->getBusBuffer(buffer, true, external.load() ? 1 : 0);
+        latencyGraph.read(zldelay::LatencyGraph<FloatType>::lookaheadTap, mainBuffer);
+        if (isMidSide) {
+            sumDifference(sideSource.getReadPointer(0), sideSource.getReadPointer(1),
+                          sideBuffer.getWritePointer(0), sideBuffer.getWritePointer(1),
+                          numSamples, FloatType(0.5));
+            sumDifference(mainBuffer.getReadPointer(0), mainBuffer.getReadPointer(1),
+                          mainBuffer.getWritePointer(0), mainBuffer.getWritePointer(1),
+                          numSamples, FloatType(0.5));
+        } else {
+            sideBuffer.makeCopyOf(sideSource, true);
         }
         // apply side gain
         auto sideBlock = juce::dsp::AudioBlock<FloatType>(sideBuffer);
         sideGainDSP.process(juce::dsp::ProcessContextReplacing<FloatType>(sideBlock));
+        // apply side-chain filters
+        sideFilter.process(sideBuffer);
 
-        // apply lookahead
-        juce::AudioBuffer<FloatType> mainBuffer(m_processor->getBusBuffer(allBuffer, true, 0));
-        auto mainBlock = juce::dsp::AudioBlock<FloatType>(mainBuffer);
-        mainDelay.process(juce::dsp::ProcessContextReplacing<FloatType>(mainBlock));
-        // add dry samples
-        dryBuffer.makeCopyOf(mainBuffer, true);
+        // read dry samples, aligned with the wet output
+        latencyGraph.read(zldelay::LatencyGraph<FloatType>::dryTap, dryBuffer);
         auto dryBlock = juce::dsp::AudioBlock<FloatType>(dryBuffer);
-        dryDelay.process(juce::dsp::ProcessContextReplacing<FloatType>(dryBlock));
         meterIn.process(dryBlock);
-        mixer.pushDrySamples(dryBlock);
         // apply over-sampling(up)
         auto allBlock = juce::dsp::AudioBlock<FloatType>(allBuffer);
-        auto overSampledBlock = overSamplers[idxSampler]->processSamplesUp(allBlock);
+        auto overSampledBlock = overSamplers[activeSampler]->processSamplesUp(allBlock);
         // ---------------- start sub buffer
         subBuffer.pushBlock(overSampledBlock);
-        while (subBuffer.isSubReady()) {
-            subBuffer.popSubBuffer();
-            switch (structureStyle.load()) {
-                case zldsp::sStyle::clean:
-                    cleanStyleProcess();
-                    break;
-                case zldsp::sStyle::gentle:
-                    gentleStyleProcess();
-                    break;
-            }
-            subBuffer.pushSubBuffer();
-        }
+        (this->*getSegmentProcess())();
         subBuffer.popBlock(overSampledBlock);
         // ---------------- end sub buffer
         // apply over-sampling(down)
-        overSamplers[idxSampler]->processSamplesDown(allBlock);
-        juce::AudioBuffer<FloatType> outBuffer(m_processor->getBusBuffer(allBuffer, true, 0));
-        auto outBlock = juce::dsp::AudioBlock<FloatType>(outBuffer);
-        // mix wet samples
+        overSamplers[activeSampler]->processSamplesDown(allBlock);
+        // check audit mode, decode mid/side on the way out
+        auto outBus = m_processor->getBusBuffer(buffer, false, 0);
+        const auto srcBus = m_processor->getBusBuffer(allBuffer, true, activeAudit ? 1 : 0);
+        if (isMidSide) {
+            sumDifference(srcBus.getReadPointer(0), srcBus.getReadPointer(1),
+                          outBus.getWritePointer(0), outBus.getWritePointer(1),
+                          numSamples, FloatType(1));
+        } else {
+            outBus.makeCopyOf(srcBus, true);
+        }
+        auto outBlock = juce::dsp::AudioBlock<FloatType>(outBus);
         meterOut.process(outBlock);
-        mixer.mixWetSamples(outBlock);
-        // apply out gain
-        if (!byPass.load()) {
+        if (!activeAudit) {
+            // mix dry samples
+            mixDrySamples(outBus);
+            // apply out gain
             outGainDSP.process(juce::dsp::ProcessContextReplacing<FloatType>(outBlock));
         }
         meterEnd.process(outBlock);
-        // check audit mode
-        if (audit.load()) {
-            m_processor->getBusBuffer(buffer, false, 0).makeCopyOf(
-                    m_processor->getBusBuffer(allBuffer, true, 1), true);
-        } else {
-            m_processor->getBusBuffer(buffer, false, 0).makeCopyOf(
-                    m_processor->getBusBuffer(allBuffer, true, 0), true);
+        if (bypassState != active) {
+            crossfadeBypass(outBus);
+        }
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::allocateBuffers(size_t blockSize, int maxDelay) {
+        // plan all block buffers and the shared delay buffer, then carve them from one allocation
+        const juce::dsp::ProcessSpec spec{mainSpec.sampleRate, static_cast<juce::uint32>(blockSize),
+                                          static_cast<juce::uint32>(numChannels)};
+        const auto stride = zlarena::Arena::getStride<FloatType>(blockSize);
+        const auto delayStride = zlarena::Arena::getStride<FloatType>(
+                static_cast<size_t>(zldelay::LatencyGraph<FloatType>::getCapacity(spec, maxDelay)));
+        arena.clear();
+        const auto allOffset = arena.add<FloatType>(stride * numChannels * 2);
+        const auto dryOffset = arena.add<FloatType>(stride * numChannels);
+        const auto bypassOffset = arena.add<FloatType>(stride * numChannels);
+        const auto delayOffset = arena.add<FloatType>(delayStride * numChannels);
+        // hold buffers cover the largest window, later window changes do not allocate
+        using Hold = zldetector::LookaheadHold<FloatType>;
+        std::array<size_t, zldsp::maxBandNum> holdValueOffsets{}, holdStepOffsets{};
+        for (size_t band = 0; band < zldsp::maxBandNum; ++band) {
+            holdValueOffsets[band] = arena.add<FloatType>(Hold::getValueNum(numChannels));
+            holdStepOffsets[band] = arena.add<size_t>(Hold::getStepNum(numChannels));
+        }
+        arena.allocate();
+        for (size_t band = 0; band < zldsp::maxBandNum; ++band) {
+            holds[band].prepare(numChannels, arena.get<FloatType>(holdValueOffsets[band]),
+                                arena.get<size_t>(holdStepOffsets[band]));
+        }
+        std::array<FloatType *, zldsp::maxChannelNum> delayChannels{};
+        for (size_t i = 0; i < numChannels; ++i) {
+            delayChannels[i] = arena.get<FloatType>(delayOffset) + i * delayStride;
+        }
+        latencyGraph.prepare(spec, maxDelay, delayChannels.data());
+        for (size_t i = 0; i < numChannels * 2; ++i) {
+            allChannels[i] = arena.get<FloatType>(allOffset) + i * stride;
+        }
+        for (size_t i = 0; i < numChannels; ++i) {
+            dryChannels[i] = arena.get<FloatType>(dryOffset) + i * stride;
+            bypassChannels[i] = arena.get<FloatType>(bypassOffset) + i * stride;
+        }
+        referBuffers(static_cast<int>(blockSize));
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::referBuffers(int numSamples) {
+        jassert(numSamples <= static_cast<int>(mainSpec.maximumBlockSize));
+        // referring to existing channels never allocates
+        allBuffer.setDataToReferTo(allChannels.data(), static_cast<int>(numChannels * 2), numSamples);
+        dryBuffer.setDataToReferTo(dryChannels.data(), static_cast<int>(numChannels), numSamples);
+        bypassBuffer.setDataToReferTo(bypassChannels.data(), static_cast<int>(numChannels), numSamples);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::resetChain() {
+        if (overSamplers[activeSampler]) {
+            overSamplers[activeSampler]->reset();
+        }
+        sideFilter.reset();
+        for (auto &hold: holds) {
+            hold.reset();
+        }
+        crossover.reset();
+        for (auto &bandTrackers: trackers) {
+            for (auto &tracker: bandTrackers) {
+                tracker.reset();
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::processIdle(juce::AudioBuffer<FloatType> &buffer) {
+        if (!isIdle) {
+            // the chain only holds signals below the floor, restart it from silence
+            // the sub buffer gets its latency samples back, so the chain is aligned when the signal returns
+            isIdle = true;
+            idleSubSamples = 0;
+            resetChain();
+            subBuffer.reset();
+        }
+        // let detectors decay as if they received silent segments
+        const auto rate = static_cast<size_t>(1) << activeSampler;
+        const auto segmentSize = static_cast<size_t>(subBuffer.subBuffer.getNumSamples());
+        idleSubSamples += static_cast<size_t>(buffer.getNumSamples()) * rate;
+        const auto numSteps = idleSubSamples / segmentSize;
+        idleSubSamples -= numSteps * segmentSize;
+        if (numSteps > 0) {
+            // loudness of an empty tracker
+            const auto silentLevel = juce::Decibels::gainToDecibels(FloatType(0)) * FloatType(0.5);
+            for (size_t band = 0; band < crossover.getBandNum(); ++band) {
+                const auto target = activeStyle == zldsp::sStyle::clean
+                                    ? computers[band].process(silentLevel)
+                                    : juce::Decibels::decibelsToGain(silentLevel);
+                detectors[band].advance(target, numChannels, numSteps);
+            }
+        }
+        // output the latency-matched input
+        auto bypassBlock = juce::dsp::AudioBlock<FloatType>(bypassBuffer);
+        outGainDSP.process(juce::dsp::ProcessContextReplacing<FloatType>(bypassBlock));
+        m_processor->getBusBuffer(buffer, false, 0).makeCopyOf(bypassBuffer, true);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::updateBypassState() {
+        const auto toBypass = byPass.load();
+        switch (bypassState) {
+            case active:
+            case fadingIn:
+                if (toBypass) {
+                    bypassState = fadingOut;
+                }
+                break;
+            case fadingOut:
+                if (!toBypass) {
+                    bypassState = fadingIn;
+                }
+                break;
+            case bypassed:
+                if (!toBypass) {
+                    // restart the chain from silence and wait until its output is valid again
+                    // the sub buffer gets its latency samples back, so the output stays aligned with the taps
+                    resetChain();
+                    subBuffer.reset();
+                    for (auto &detector: detectors) {
+                        detector.reset();
+                    }
+                    isIdle = false;
+                    warmUpSamples = latencySamples;
+                    bypassState = warmingUp;
+                }
+                break;
+            case warmingUp:
+                if (toBypass) {
+                    bypassState = bypassed;
+                }
+                break;
+        }
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::crossfadeBypass(juce::AudioBuffer<FloatType> &buffer) {
+        std::array<FloatType *, zldsp::maxChannelNum> wet{};
+        std::array<const FloatType *, zldsp::maxChannelNum> dry{};
+        for (size_t i = 0; i < numChannels; ++i) {
+            wet[i] = buffer.getWritePointer(static_cast<int>(i));
+            dry[i] = bypassBuffer.getReadPointer(static_cast<int>(i));
+        }
+        const auto scale = FloatType(1) / static_cast<FloatType>(fadeLength);
+        for (int n = 0; n < buffer.getNumSamples(); ++n) {
+            switch (bypassState) {
+                case fadingOut:
+                    fadePos = juce::jmax(0, fadePos - 1);
+                    if (fadePos == 0) {
+                        bypassState = bypassed;
+                    }
+                    break;
+                case fadingIn:
+                    fadePos = juce::jmin(fadeLength, fadePos + 1);
+                    if (fadePos == fadeLength) {
+                        bypassState = active;
+                    }
+                    break;
+                case warmingUp:
+                    if (warmUpSamples > 0) {
+                        warmUpSamples -= 1;
+                    } else {
+                        bypassState = fadingIn;
+                    }
+                    break;
+                case active:
+                case bypassed:
+                    break;
+            }
+            const auto w = static_cast<FloatType>(fadePos) * scale;
+            for (size_t i = 0; i < numChannels; ++i) {
+                wet[i][n] = dry[i][n] + w * (wet[i][n] - dry[i][n]);
+            }
         }
     }
 
@@ -141,88 +488,124 @@ namespace zlcontroller {
 
     template<typename FloatType>
     void Controller<FloatType>::setMixProportion(FloatType v) {
-        mixer.setWetMixProportion(v);
+        mixProportion.store(v);
     }
 
     template<typename FloatType>
-    void Controller<FloatType>::setOversampleID(size_t idx, bool useLock) {
-        if (useLock) {
-            const juce::GenericScopedLock<juce::CriticalSection> processLock(m_processor->getCallbackLock());
-            toSetOversampleID(idx);
-        } else {
-            toSetOversampleID(idx);
+    void Controller<FloatType>::mixDrySamples(juce::AudioBuffer<FloatType> &buffer) {
+        wetMix.setTargetValue(mixProportion.load());
+        if (!wetMix.isSmoothing() && wetMix.getTargetValue() >= FloatType(1)) {
+            return;
+        }
+        std::array<FloatType *, zldsp::maxChannelNum> wet{};
+        std::array<const FloatType *, zldsp::maxChannelNum> dry{};
+        for (size_t i = 0; i < numChannels; ++i) {
+            wet[i] = buffer.getWritePointer(static_cast<int>(i));
+            dry[i] = dryBuffer.getReadPointer(static_cast<int>(i));
+        }
+        for (int n = 0; n < buffer.getNumSamples(); ++n) {
+            const auto w = wetMix.getNextValue();
+            for (size_t i = 0; i < numChannels; ++i) {
+                wet[i][n] = dry[i][n] + w * (wet[i][n] - dry[i][n]);
+            }
         }
     }
 
     template<typename FloatType>
-    void Controller<FloatType>::toSetOversampleID(size_t idx) {
+    void Controller<FloatType>::setOversampleID(size_t idx) {
         idxSampler.store(idx);
+        markPending(samplerChange);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::toSetOversampleID(size_t idx) {
+        activeSampler = idx;
         auto rate = std::pow(2, idx);
         juce::dsp::ProcessSpec spec{mainSpec.sampleRate * rate,
                                     mainSpec.maximumBlockSize * static_cast<juce::uint32>(rate),
                                     mainSpec.numChannels};
         subBuffer.prepare({spec.sampleRate, spec.maximumBlockSize, spec.numChannels * 2});
-        setSegment(segment.load(), false);
+        toSetSegment(segment.load());
     }
 
     template<typename FloatType>
-    void Controller<FloatType>::setRMSSize(FloatType v, bool useLock) {
-        if (useLock) {
-            const juce::GenericScopedLock<juce::CriticalSection> processLock(m_processor->getCallbackLock());
-            toSetRMSSize(v);
-        } else {
-            toSetRMSSize(v);
-        }
+    void Controller<FloatType>::setRMSSize(FloatType v) {
+        rmsSize.store(v);
+        markPending(rmsChange);
     }
 
     template<typename FloatType>
     void Controller<FloatType>::toSetRMSSize(FloatType v) {
-        rmsSize.store(v);
         auto mSize = static_cast<size_t>(subBuffer.getSubSpec().sampleRate * v /
                                          subBuffer.getSubSpec().maximumBlockSize);
         mSize = juce::jmax(size_t(1), mSize);
-        lTracker.reset();
-        rTracker.reset();
-        lTracker.setMomentarySize(mSize);
-        rTracker.setMomentarySize(mSize);
+        for (auto &bandTrackers: trackers) {
+            for (auto &tracker: bandTrackers) {
+                tracker.reset();
+                tracker.setMomentarySize(mSize);
+            }
+        }
     }
 
     template<typename FloatType>
     void Controller<FloatType>::setLookAhead(FloatType v) {
-        mainDelay.setDelay(static_cast<float>(static_cast<int>(v * mainSpec.sampleRate)));
-        setLatency();
+        lookAhead.store(v);
+        markPending(lookaheadChange);
     }
 
     template<typename FloatType>
-    void Controller<FloatType>::setSegment(FloatType v, bool useLock) {
-        if (useLock) {
-            const juce::GenericScopedLock<juce::CriticalSection> processLock(m_processor->getCallbackLock());
-            toSetSegment(v);
-        } else {
-            toSetSegment(v);
+    void Controller<FloatType>::setLookaheadHold(bool f) {
+        lookaheadHold.store(f);
+        markPending(lookaheadChange);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::updateHoldSize() {
+        // the window covers the lookahead, in segments
+        const auto subSpec = subBuffer.getSubSpec();
+        const auto windowSize = lookaheadHold.load()
+                                ? static_cast<size_t>(std::round(lookAhead.load() * subSpec.sampleRate /
+                                                                 subSpec.maximumBlockSize))
+                                : size_t(1);
+        for (size_t band = 0; band < zldsp::maxBandNum; ++band) {
+            holds[band].setWindowSize(band < crossover.getBandNum() ? windowSize : 1);
         }
     }
 
     template<typename FloatType>
-    void Controller<FloatType>::toSetSegment(FloatType v) {
+    void Controller<FloatType>::setSegment(FloatType v) {
         segment.store(v);
+        markPending(segmentChange);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::toSetSegment(FloatType v) {
         subBuffer.setSubBufferSize(juce::jmax(1, static_cast<int>(v * subBuffer.getMainSpec().sampleRate)));
 
+        // each tracker handles a single channel
         juce::dsp::ProcessSpec spec = subBuffer.getSubSpec();
-        spec.numChannels = spec.numChannels / 2;
-        spec.numChannels = spec.numChannels / 2;
-        lTracker.prepare(spec);
-        rTracker.prepare(spec);
-        lDetector.prepare(spec);
-        rDetector.prepare(spec);
-        lGainDSP.prepare(spec);
-        rGainDSP.prepare(spec);
-
-        auto rampSeconds = double(spec.maximumBlockSize) / 4 / spec.sampleRate;
-        lGainDSP.setRampDurationSeconds(rampSeconds);
-        rGainDSP.setRampDurationSeconds(rampSeconds);
-
-        setRMSSize(rmsSize.load(), false);
+        spec.numChannels = 1;
+        gainRamp.prepare(static_cast<size_t>(spec.maximumBlockSize));
+        for (size_t band = 0; band < zldsp::maxBandNum; ++band) {
+            detectors[band].prepare(spec);
+            for (auto &tracker: trackers[band]) {
+                tracker.prepare(spec);
+            }
+        }
+
+        // band buffers hold main and side channels of the sub buffer, interleaved
+        // they have their own arena, which only grows, so re-planning never touches the delay line
+        crossover.prepare(spec.sampleRate, numChannels * 2);
+        bandArena.clear();
+        const auto bandOffset = bandArena.add<FloatType>(zldsp::maxBandNum * spec.maximumBlockSize * numChannels * 2);
+        bandArena.allocate();
+        bandData = bandArena.get<FloatType>(bandOffset);
+        for (auto &gains: prevBandGains) {
+            gains.fill(FloatType(1));
+        }
+
+        toSetRMSSize(rmsSize.load());
+        updateHoldSize();
         setLatency();
     }
 
@@ -233,9 +616,8 @@ namespace zlcontroller {
 
     template<typename FloatType>
     void Controller<FloatType>::setAudit(bool f) {
-        const juce::GenericScopedLock<juce::CriticalSection> scopedLock(m_processor->getCallbackLock());
         audit.store(f);
-        setLatency();
+        markPending(auditChange);
     }
 
     template<typename FloatType>
@@ -248,102 +630,337 @@ namespace zlcontroller {
         byPass.store(f);
     }
 
+    template<typename FloatType>
+    void Controller<FloatType>::setSilenceFloor(FloatType v) {
+        // the floor can be lower than the default minus infinity of juce::Decibels
+        silenceFloor.store(juce::Decibels::decibelsToGain(v, FloatType(-200)));
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setMidSide(bool f) {
+        midSide.store(f);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setMorphOn(bool f) {
+        morphOn.store(f);
+        toMorph.store(true);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setMorph(FloatType v) {
+        morphPos.store(v);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setMorphSlot(size_t slot, size_t idx, FloatType v) {
+        morphSlots[slot][idx].store(v);
+        toMorph.store(true);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setMorphTask(Dispatcher &dispatcher, size_t task) {
+        morphDispatcher = &dispatcher;
+        morphTask = task;
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::updateMorph() {
+        if (!morphOn.load()) {
+            return;
+        }
+        const auto pos = juce::jlimit(FloatType(0), FloatType(zldsp::maxMorphSlotNum - 1), morphPos.load());
+        if (!toMorph.exchange(false) && pos == currentMorphPos) {
+            return;
+        }
+        currentMorphPos = pos;
+        // linear interpolation between two adjacent slots
+        const auto i0 = juce::jmin(static_cast<size_t>(pos), static_cast<size_t>(zldsp::maxMorphSlotNum - 2));
+        const auto w = pos - static_cast<FloatType>(i0);
+        std::array<FloatType, zldsp::morphSlot::paraNUM> values{};
+        for (size_t idx = 0; idx < values.size(); ++idx) {
+            const auto v0 = morphSlots[i0][idx].load(), v1 = morphSlots[i0 + 1][idx].load();
+            values[idx] = v0 + (v1 - v0) * w;
+        }
+        // the slots store the global parameters, which drive the first band
+        using slot = zldsp::morphSlot;
+        computers[0].setParameters(values[slot::thresholdIdx], values[slot::ratioIdx],
+                                   zldsp::kneeW::formatV(values[slot::kneeWIdx]),
+                                   values[slot::kneeDIdx], values[slot::kneeSIdx], values[slot::boundIdx]);
+        if (morphDispatcher != nullptr) {
+            morphDispatcher->post(morphTask);
+        }
+    }
+
     template<typename FloatType>
     void Controller<FloatType>::setLatency() {
-        if (!overSamplers[idxSampler.load()]) {
+        if (!overSamplers[activeSampler]) {
             return;
         }
-        if (audit.load()) {
-            m_processor->setLatencySamples(
-                    static_cast<int>(overSamplers[idxSampler.load()]->getLatencyInSamples()) +
-                    static_cast<int>(subBuffer.getLatencySamples() / std::pow(2, idxSampler.load())));
-        } else {
-            m_processor->setLatencySamples(
-                    static_cast<int>(mainDelay.getDelay() + overSamplers[idxSampler.load()]->getLatencyInSamples()) +
-                    static_cast<int>(subBuffer.getLatencySamples() / std::pow(2, idxSampler.load())));
+        using graph = zldelay::LatencyGraph<FloatType>;
+        // the sub buffer and the crossover run at the over-sampled rate
+        const auto rate = std::pow(2, activeSampler);
+        latencyGraph.setStageLatency(graph::lookaheadStage, static_cast<int>(lookAhead.load() * mainSpec.sampleRate));
+        latencyGraph.setStageLatency(graph::overSampleStage,
+                                     static_cast<int>(overSamplers[activeSampler]->getLatencyInSamples()));
+        latencyGraph.setStageLatency(graph::segmentStage, static_cast<int>(subBuffer.getLatencySamples() / rate));
+        latencyGraph.setStageLatency(graph::crossoverStage, static_cast<int>(crossover.getLatencySamples() / rate));
+        // the output switches to the side-chain together with the latency
+        activeAudit = audit.load();
+        latencyGraph.setAudit(activeAudit);
+        latencySamples = latencyGraph.getLatency();
+        // only the controller of the current precision reports latency
+        if (m_processor->isUsingDoublePrecision() == std::is_same_v<FloatType, double>) {
+            m_processor->setLatencySamples(latencySamples);
         }
-        dryDelay.setDelay(static_cast<float>(overSamplers[idxSampler.load()]->getLatencyInSamples()) +
-                          static_cast<float>(subBuffer.getLatencySamples() / std::pow(2, idxSampler.load())));
     }
 
     template<typename FloatType>
     void Controller<FloatType>::setStructureStyleID(size_t idx) {
-        const juce::GenericScopedLock<juce::CriticalSection> processLock(m_processor->getCallbackLock());
         structureStyle.store(idx);
-        lDetector.reset();
-        rDetector.reset();
-        lGainDSP.reset();
-        rGainDSP.reset();
-        if (idx == zldsp::sStyle::clean) {
-            lDetector.setPhase(zldetector::Detector<FloatType>::gain);
-            rDetector.setPhase(zldetector::Detector<FloatType>::gain);
+        markPending(styleChange);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::toSetStructureStyleID(size_t idx) {
+        activeStyle = idx;
+        gainRamp.reset();
+        for (auto &detector: detectors) {
+            detector.reset();
+            if (idx == zldsp::sStyle::clean) {
+                detector.setPhase(zldetector::Detector<FloatType>::gain);
+            } else {
+                detector.setPhase(zldetector::Detector<FloatType>::level);
+            }
+        }
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setLinkGroupID(size_t idx) {
+        linkGroupID.store(idx);
+        markPending(linkGroupChange);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::toSetLinkGroupID(size_t idx) {
+        const auto layout = m_processor->getChannelLayoutOfBus(true, 0);
+        std::array<juce::AudioChannelSet::ChannelType, zldsp::maxChannelNum> types{};
+        for (size_t i = 0; i < numChannels; ++i) {
+            types[i] = layout.getTypeOfChannel(static_cast<int>(i));
+        }
+        numLinkGroups = 0;
+        std::optional<size_t> sharedGroup;
+        for (size_t i = 0; i < numChannels; ++i) {
+            const auto isLFE = types[i] == juce::AudioChannelSet::LFE || types[i] == juce::AudioChannelSet::LFE2;
+            std::optional<size_t> group;
+            if (idx == zldsp::linkGroup::all || (idx == zldsp::linkGroup::noLFE && !isLFE)) {
+                // all channels (except LFE channels for noLFE) share one group
+                if (!sharedGroup.has_value()) {
+                    sharedGroup = numLinkGroups++;
+                }
+                group = sharedGroup;
+            } else if (idx == zldsp::linkGroup::pairs) {
+                // join the group of the paired channel if it comes first
+                const auto pairedType = getPairedChannelType(types[i]);
+                for (size_t j = 0; j < i && pairedType != juce::AudioChannelSet::unknown; ++j) {
+                    if (types[j] == pairedType) {
+                        group = linkGroups[j];
+                        break;
+                    }
+                }
+            }
+            if (!group.has_value()) {
+                group = numLinkGroups++;
+            }
+            linkGroups[i] = group.value();
+        }
+        std::array<size_t, zldsp::maxChannelNum> groupSizes{};
+        for (size_t i = 0; i < numChannels; ++i) {
+            groupSizes[linkGroups[i]] += 1;
+        }
+        for (size_t i = 0; i < numChannels; ++i) {
+            linkWeights[i] = FloatType(1) / static_cast<FloatType>(groupSizes[linkGroups[i]]);
+        }
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::linkLevels() {
+        // move each channel towards the mean level of its link group
+        // link is in [0, 0.5], so the blend weight reaches 1 at full link
+        std::fill(groupMeans.begin(), groupMeans.begin() + static_cast<std::ptrdiff_t>(numLinkGroups), FloatType(0));
+        for (size_t i = 0; i < numChannels; ++i) {
+            groupMeans[linkGroups[i]] += levels[i] * linkWeights[i];
+        }
+        const auto w = link.load() * 2;
+        for (size_t i = 0; i < numChannels; ++i) {
+            levels[i] += w * (groupMeans[linkGroups[i]] - levels[i]);
+        }
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::applyGains() {
+        gainRamp.process(subBuffer.subBuffer.getArrayOfWritePointers(), levels.data(),
+                         numChannels, static_cast<size_t>(subBuffer.subBuffer.getNumSamples()));
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setBandNum(size_t idx) {
+        bandIdx.store(idx);
+        markPending(bandNumChange);
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::toSetBandNum(size_t idx) {
+        crossover.setBandNum(zldsp::bandNum::getBandNum(idx));
+        // keep the sub buffer (and its latency samples) running, only restart the band states
+        resetBands();
+        updateHoldSize();
+        setLatency();
+    }
+
+    template<typename FloatType>
+    void Controller<FloatType>::setCrossoverFreq(size_t idx, FloatType v) {
+        crossover.setFreq(idx, v);
+    }
+
+    template<typename FloatType>
+    typename Controller<FloatType>::SegmentProcess Controller<FloatType>::getSegmentProcess() const {
+        static constexpr std::array<std::array<SegmentProcess, zldsp::sStyle::structureNUM>, 2> variants{{
+            {&Controller<FloatType>::processSegments<false, zldsp::sStyle::clean>,
+             &Controller<FloatType>::processSegments<false, zldsp::sStyle::gentle>},
+            {&Controller<FloatType>::processSegments<true, zldsp::sStyle::clean>,
+             &Controller<FloatType>::processSegments<true, zldsp::sStyle::gentle>}
+        }};
+        const auto style = juce::jmin(activeStyle, static_cast<size_t>(zldsp::sStyle::structureNUM - 1));
+        return variants[crossover.getBandNum() > 1 ? 1 : 0][style];
+    }
+
+    template<typename FloatType>
+    template<bool IsMultiband, size_t Style>
+    void Controller<FloatType>::processSegments() {
+        while (subBuffer.isSubReady()) {
+            subBuffer.popSubBuffer();
+            if constexpr (IsMultiband) {
+                multibandProcess<Style>();
+            } else {
+                singleBandProcess<Style>();
+            }
+            subBuffer.pushSubBuffer();
+        }
+    }
+
+    template<typename FloatType>
+    template<size_t Style>
+    void Controller<FloatType>::singleBandProcess() {
+        // calculate rms value of each side channel
+        for (size_t i = 0; i < numChannels; ++i) {
+            trackers[0][i].process(subBuffer.getSubBufferChannels(static_cast<int>(numChannels + i), 1));
+        }
+        computeGains<Style>(0);
+        holds[0].process(levels.data());
+        // apply the gains of all channels in one pass
+        applyGains();
+    }
+
+    template<typename FloatType>
+    template<size_t Style>
+    void Controller<FloatType>::multibandProcess() {
+        const auto numBands = crossover.getBandNum();
+        const auto numLanes = numChannels * 2;
+        const auto numSamples = static_cast<size_t>(subBuffer.subBuffer.getNumSamples());
+        std::array<FloatType *, zldsp::maxBandNum> bands{};
+        for (size_t band = 0; band < numBands; ++band) {
+            bands[band] = bandData + band * numSamples * numLanes;
+        }
+        // interleave main and side channels into the highest band and split
+        for (size_t lane = 0; lane < numLanes; ++lane) {
+            const auto *src = subBuffer.subBuffer.getReadPointer(static_cast<int>(lane));
+            for (size_t n = 0; n < numSamples; ++n) {
+                bands[numBands - 1][n * numLanes + lane] = src[n];
+            }
+        }
+        crossover.process(bands, numSamples);
+        // calculate rms value of each side channel and compute gains of each band
+        for (size_t band = 0; band < numBands; ++band) {
+            std::array<FloatType, zldsp::maxChannelNum> meanSquares{};
+            for (size_t n = 0; n < numSamples; ++n) {
+                const auto *x = bands[band] + n * numLanes + numChannels;
+                for (size_t i = 0; i < numChannels; ++i) {
+                    meanSquares[i] += x[i] * x[i];
+                }
+            }
+            for (size_t i = 0; i < numChannels; ++i) {
+                trackers[band][i].processMeanSquare(meanSquares[i] / static_cast<FloatType>(numSamples));
+            }
+            computeGains<Style>(band);
+            holds[band].process(levels.data());
+            std::copy(levels.begin(), levels.begin() + static_cast<std::ptrdiff_t>(numChannels),
+                      bandGains[band].begin());
+        }
+        // apply gains (ramped over the first quarter) and sum the bands in one pass
+        std::array<FloatType *, zldsp::maxChannelNum> dest{};
+        for (size_t i = 0; i < numChannels; ++i) {
+            dest[i] = subBuffer.subBuffer.getWritePointer(static_cast<int>(i));
+        }
+        for (size_t n = 0; n < numSamples; ++n) {
+            const auto t = gainRamp.getPosition(n);
+            std::array<FloatType, zldsp::maxChannelNum> sums{};
+            for (size_t band = 0; band < numBands; ++band) {
+                const auto *x = bands[band] + n * numLanes;
+                const auto &g0 = prevBandGains[band], &g1 = bandGains[band];
+                for (size_t i = 0; i < numChannels; ++i) {
+                    sums[i] += x[i] * (g0[i] + t * (g1[i] - g0[i]));
+                }
+            }
+            for (size_t i = 0; i < numChannels; ++i) {
+                dest[i][n] = sums[i];
+            }
+        }
+        prevBandGains = bandGains;
+    }
+
+    template<typename FloatType>
+    template<size_t Style>
+    void Controller<FloatType>::computeGains(size_t band) {
+        if constexpr (Style == zldsp::sStyle::clean) {
+            cleanStyleProcess(band);
         } else {
-            lDetector.setPhase(zldetector::Detector<FloatType>::level);
-            rDetector.setPhase(zldetector::Detector<FloatType>::level);
+            gentleStyleProcess(band);
         }
     }
 
     template<typename FloatType>
-    void Controller<FloatType>::cleanStyleProcess() {
-        // calculate rms value
-        lTracker.process(subBuffer.getSubBufferChannels(2, 1));
-        rTracker.process(subBuffer.getSubBufferChannels(3, 1));
+    void Controller<FloatType>::cleanStyleProcess(size_t band) {
         // compute current loudness level
-        FloatType l = lTracker.getMomentaryLoudness();
-        FloatType r = rTracker.getMomentaryLoudness();
-        FloatType lr = l + r;
-        // perform stereo link
-        l = link.load() * r + (1 - link.load()) * l;
-        r = lr - l;
+        for (size_t i = 0; i < numChannels; ++i) {
+            levels[i] = trackers[band][i].getMomentaryLoudness();
+        }
+        // perform link
+        linkLevels();
         // compute current gain
-        l = lrComputer.process(l);
-        r = lrComputer.process(r);
-        // attack/release current gain
-        l = lDetector.process(l);
-        r = rDetector.process(r);
-        // apply gain separately
-        if (!byPass.load()) {
-            lGainDSP.setGainLinear(l);
-            rGainDSP.setGainLinear(r);
-            auto lSubBlock = subBuffer.getSubBlockChannels(0, 1);
-            lGainDSP.process(juce::dsp::ProcessContextReplacing<FloatType>(lSubBlock));
-            auto rSubBlock = subBuffer.getSubBlockChannels(1, 1);
-            rGainDSP.process(juce::dsp::ProcessContextReplacing<FloatType>(rSubBlock));
+        for (size_t i = 0; i < numChannels; ++i) {
+            levels[i] = computers[band].process(levels[i]);
         }
+        // attack/release current gain
+        detectors[band].process(levels.data(), numChannels);
     }
 
     template<typename FloatType>
-    void Controller<FloatType>::gentleStyleProcess() {
-        // calculate rms value
-        lTracker.process(subBuffer.getSubBufferChannels(2, 1));
-        rTracker.process(subBuffer.getSubBufferChannels(3, 1));
-        // compute current loudness level
-        FloatType l = lTracker.getMomentaryLoudness();
-        FloatType r = rTracker.getMomentaryLoudness();
-        // convert gain to linear domain
-        l = juce::Decibels::decibelsToGain(l);
-        r = juce::Decibels::decibelsToGain(r);
-        // attack/release current gain
-        l = lDetector.process(l);
-        r = rDetector.process(r);
-        // convert gain to db domain
-        l = juce::Decibels::gainToDecibels(l);
-        r = juce::Decibels::gainToDecibels(r);
-        FloatType lr = l + r;
-        // perform stereo link
-        l = link.load() * r + (1 - link.load()) * l;
-        r = lr - l;
+    void Controller<FloatType>::gentleStyleProcess(size_t band) {
+        // convert loudness level to linear domain
+        for (size_t i = 0; i < numChannels; ++i) {
+            levels[i] = trackers[band][i].getMomentaryLoudness();
+        }
+        zlmath::decibelsToGain(levels.data(), numChannels);
+        // attack/release current level
+        detectors[band].process(levels.data(), numChannels);
+        // convert level to db domain
+        zlmath::gainToDecibels(levels.data(), numChannels);
+        // perform link
+        linkLevels();
         // compute current gain
-        l = lrComputer.process(l);
-        r = lrComputer.process(r);
-        // apply gain separately
-        if (!byPass.load()) {
-            lGainDSP.setGainLinear(l);
-            rGainDSP.setGainLinear(r);
-            auto lSubBlock = subBuffer.getSubBlockChannels(0, 1);
-            lGainDSP.process(juce::dsp::ProcessContextReplacing<FloatType>(lSubBlock));
-            auto rSubBlock = subBuffer.getSubBlockChannels(1, 1);
-            rGainDSP.process(juce::dsp::ProcessContextReplacing<FloatType>(rSubBlock));
+        for (size_t i = 0; i < numChannels; ++i) {
+            levels[i] = computers[band].process(levels[i]);
         }
     }
 
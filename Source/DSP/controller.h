@@ -14,8 +14,16 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "dsp_definitions.h"
+#include "dispatcher.h"
+#include "footprint.h"
+#include "Arena/arena.h"
 #include "Computer/computer.h"
+#include "Crossover/crossover.h"
+#include "Delay/latency_graph.h"
+#include "Filter/side_filter.h"
+#include "Gain/gain_ramp.h"
 #include "Detector/detector.h"
+#include "Detector/lookahead_hold.h"
 #include "Detector/rms_tracker.h"
 #include "FixedBuffer/fixed_audio_buffer.h"
 #include "Meter/meter.h"
@@ -24,10 +32,14 @@ namespace zlcontroller {
     template<typename FloatType>
     class Controller {
     public:
-        zldetector::Detector<FloatType> lDetector, rDetector;
-        zldetector::RMSTracker<FloatType> lTracker, rTracker;
-        zlcomputer::Computer<FloatType> lrComputer;
-        zlmeter::MeterSource<FloatType> meterIn, meterOut, meterEnd;
+        // one detector/computer for each band, one tracker for each band and channel
+        // the first band follows the global parameters, later bands follow zldsp::bandParameters
+        std::array<zldetector::Detector<FloatType>, zldsp::maxBandNum> detectors;
+        std::array<std::array<zldetector::RMSTracker<FloatType>, zldsp::maxChannelNum>, zldsp::maxBandNum> trackers;
+        std::array<zlcomputer::Computer<FloatType>, zldsp::maxBandNum> computers;
+        zlfilter::SideFilter<FloatType> sideFilter;
+        // meters always display in float, so that the editor does not depend on the processing precision
+        zlmeter::MeterSource<float> meterIn, meterOut, meterEnd;
 
         explicit Controller(juce::AudioProcessor &processor,
                             juce::AudioProcessorValueTreeState &parameters);
@@ -36,6 +48,11 @@ namespace zlcontroller {
 
         void prepare(juce::dsp::ProcessSpec spec);
 
+        /**
+         * stop applying setting changes until the next prepare, the controller then only stores the values
+         */
+        void release();
+
         void reset();
 
         void process(juce::AudioBuffer<FloatType> &buffer);
@@ -46,19 +63,15 @@ namespace zlcontroller {
 
         void setMixProportion(FloatType v);
 
-        void setOversampleID(size_t idx, bool useLock = true);
-
-        void toSetOversampleID(size_t idx);
-
-        void setRMSSize(FloatType v, bool useLock = true);
+        void setOversampleID(size_t idx);
 
-        void toSetRMSSize(FloatType v);
+        void setRMSSize(FloatType v);
 
         void setLookAhead(FloatType v);
 
-        void setSegment(FloatType v, bool useLock = true);
+        void setLookaheadHold(bool f);
 
-        void toSetSegment(FloatType v);
+        void setSegment(FloatType v);
 
         void setLink(FloatType v);
 
@@ -68,35 +81,200 @@ namespace zlcontroller {
 
         void setByPass(bool f);
 
+        void setSilenceFloor(FloatType v);
+
+        void setMidSide(bool f);
+
         void setStructureStyleID(size_t idx);
 
-    private:
-        std::array<std::unique_ptr<juce::dsp::Oversampling<FloatType>>, zldsp::overSample::overSampleNUM>
-                overSamplers{};
-        std::atomic<size_t> idxSampler, structureStyle;
+        void setLinkGroupID(size_t idx);
 
-        std::atomic<bool> audit, external, byPass;
-        std::atomic<FloatType> link;
-        juce::dsp::Gain<FloatType> sideGainDSP, outGainDSP, lGainDSP, rGainDSP;
-        juce::dsp::DelayLine<FloatType> mainDelay, dryDelay;
-        juce::dsp::DryWetMixer<FloatType> mixer;
+        void setBandNum(size_t idx);
 
-        fixedBuffer::FixedAudioBuffer<FloatType> subBuffer;
+        void setCrossoverFreq(size_t idx, FloatType v);
+
+        void setMorphOn(bool f);
+
+        inline bool getMorphOn() const { return morphOn.load(); }
+
+        void setMorph(FloatType v);
+
+        void setMorphSlot(size_t slot, size_t idx, FloatType v);
+
+        /**
+         * post the task whenever the morph rebuilds the curves, call it on the message thread before processing
+         */
+        void setMorphTask(Dispatcher &dispatcher, size_t task);
+
+        /**
+         * the setters of settings which reconfigure the chain only store the value, they are wait-free
+         * the reconfiguration (which allocates and takes the callback lock) is applied off the audio thread,
+         * right away on the message thread and by the dispatcher for other threads
+         * a controller which is not prepared keeps the values until prepare
+         */
+        inline bool hasPendingChanges() const { return isPrepared.load() && toApply.load() != 0; }
+
+        void applyPendingChanges();
+
+        /**
+         * bytes held by the processing chain, should be called under the callback lock
+         */
+        Footprint getFootprint() const;
+
+        zldsp::Layout getLayout() const {
+            return {zldsp::getOffset(this, &idxSampler), zldsp::getOffset(this, &isPrepared) + sizeof(isPrepared),
+                    zldsp::getOffset(this, &overSamplers), sizeof(*this)};
+        }
+
+    private:
+        // ---------------- parameters, written by the message thread
+        alignas(zldsp::cacheLineSize) std::atomic<size_t> idxSampler;
+        std::atomic<size_t> structureStyle;
+        std::atomic<bool> audit, external, byPass, midSide;
+        std::atomic<FloatType> link;
+        std::atomic<FloatType> mixProportion{1};
         std::atomic<FloatType> segment;
         std::atomic<FloatType> rmsSize;
+        std::atomic<FloatType> lookAhead{0};
+        std::atomic<bool> lookaheadHold{false};
+        // link group of each channel
+        std::atomic<size_t> linkGroupID;
+        // morph: computer parameters of the first band are interpolated between the slots once per block
+        std::atomic<bool> morphOn{false}, toMorph{false};
+        std::atomic<FloatType> morphPos{0};
+        std::array<std::array<std::atomic<FloatType>, zldsp::morphSlot::paraNUM>, zldsp::maxMorphSlotNum> morphSlots;
+        Dispatcher *morphDispatcher = nullptr;
+        size_t morphTask = 0;
+        // idle: main and side-chain inputs stay below the silence floor
+        std::atomic<FloatType> silenceFloor;
+        std::atomic<size_t> bandIdx{zldsp::bandNum::defaultI};
+        // settings which have been stored but not applied yet
+        enum PendingChange : juce::uint32 {
+            samplerChange = 1 << 0, segmentChange = 1 << 1, rmsChange = 1 << 2, lookaheadChange = 1 << 3,
+            styleChange = 1 << 4, linkGroupChange = 1 << 5, bandNumChange = 1 << 6, auditChange = 1 << 7
+        };
+        std::atomic<juce::uint32> toApply{0};
+        std::atomic<bool> isPrepared{false};
+
+        // ---------------- states, only touched by the audio thread (or under the callback lock)
+        alignas(zldsp::cacheLineSize) std::array<std::unique_ptr<juce::dsp::Oversampling<FloatType>>,
+                zldsp::overSample::overSampleNUM> overSamplers{};
+        size_t preparedOverSampleChannels = 0;
+        // the applied settings that the audio thread reads
+        size_t activeSampler = 0, activeStyle = 0;
+        bool activeAudit = false;
+
+        juce::dsp::Gain<FloatType> sideGainDSP, outGainDSP;
+        // gains of all channels are ramped and applied in one pass over the sub buffer
+        zlgain::GainRamp<FloatType> gainRamp;
+        // all delays (lookahead, dry, bypass) are taps of one shared delay buffer
+        zldelay::LatencyGraph<FloatType> latencyGraph;
+        juce::SmoothedValue<FloatType> wetMix;
+
+        fixedBuffer::FixedAudioBuffer<FloatType> subBuffer;
+
+        // lookahead hold of the gains of each band
+        std::array<zldetector::LookaheadHold<FloatType>, zldsp::maxBandNum> holds;
 
         juce::dsp::ProcessSpec mainSpec = {44100, 512, 2};
+        size_t numChannels = 2;
+
+        // the link group of each channel, and the weight of each channel in its group mean
+        std::array<size_t, zldsp::maxChannelNum> linkGroups{};
+        std::array<FloatType, zldsp::maxChannelNum> linkWeights{};
+        size_t numLinkGroups = 1;
+        std::array<FloatType, zldsp::maxChannelNum> levels{}, groupMeans{};
+
+        // multiband: interleaved band buffers and the gains of each band/channel
+        zlcrossover::CrossoverBank<FloatType> crossover;
+        zlarena::Arena bandArena;
+        FloatType *bandData = nullptr;
+        std::array<std::array<FloatType, zldsp::maxChannelNum>, zldsp::maxBandNum> bandGains{}, prevBandGains{};
 
         juce::AudioProcessor *m_processor;
         juce::AudioProcessorValueTreeState *apvts;
 
+        // block buffers, the delay buffer and the hold buffers refer to memory carved from the arena at prepare time
+        zlarena::Arena arena;
+        std::array<FloatType *, zldsp::maxChannelNum * 2> allChannels{};
+        std::array<FloatType *, zldsp::maxChannelNum> dryChannels{}, bypassChannels{};
         juce::AudioBuffer<FloatType> allBuffer, dryBuffer;
 
+        // bypass: the input is delayed by the reported latency and cross-faded with the processed output
+        enum BypassState {
+            active, fadingOut, bypassed, warmingUp, fadingIn
+        };
+        BypassState bypassState = active;
+        juce::AudioBuffer<FloatType> bypassBuffer;
+        int latencySamples = 0, warmUpSamples = 0;
+        int fadePos = 0, fadeLength = 1;
+
+        FloatType currentMorphPos{-1};
+
+        bool isIdle = false;
+        int silentSamples = 0;
+        size_t idleSubSamples = 0;
+
+        inline void markPending(PendingChange change) { toApply.fetch_or(change); }
+
+        void toSetOversampleID(size_t idx);
+
+        void toSetRMSSize(FloatType v);
+
+        void toSetSegment(FloatType v);
+
+        void toSetStructureStyleID(size_t idx);
+
+        void toSetLinkGroupID(size_t idx);
+
+        void toSetBandNum(size_t idx);
+
         void setLatency();
 
-        void cleanStyleProcess();
+        void allocateBuffers(size_t blockSize, int maxDelay);
+
+        void referBuffers(int numSamples);
+
+        void mixDrySamples(juce::AudioBuffer<FloatType> &buffer);
+
+        void resetChain();
+
+        void resetBands();
+
+        void updateHoldSize();
+
+        void processIdle(juce::AudioBuffer<FloatType> &buffer);
+
+        void updateBypassState();
+
+        void crossfadeBypass(juce::AudioBuffer<FloatType> &buffer);
+
+        void updateMorph();
+
+        void linkLevels();
+
+        void applyGains();
+
+        // the segment loop is specialized for each band mode and structure style, chosen once per block
+        using SegmentProcess = void (Controller<FloatType>::*)();
+
+        SegmentProcess getSegmentProcess() const;
+
+        template<bool IsMultiband, size_t Style>
+        void processSegments();
+
+        template<size_t Style>
+        void singleBandProcess();
+
+        template<size_t Style>
+        void multibandProcess();
+
+        template<size_t Style>
+        void computeGains(size_t band);
+
+        void cleanStyleProcess(size_t band);
 
-        void gentleStyleProcess();
+        void gentleStyleProcess(size_t band);
     };
 }
 
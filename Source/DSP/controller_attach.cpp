@@ -15,11 +15,20 @@ namespace zlcontroller {
     ControllerAttach<FloatType>::ControllerAttach(juce::AudioProcessor &processor,
                                                   Controller<FloatType> &c,
                                                   juce::AudioProcessorValueTreeState &parameters,
-                                                  juce::AudioProcessorValueTreeState &parametersNA) {
+                                                  juce::AudioProcessorValueTreeState &parametersNA,
+                                                  Dispatcher &dispatcher) {
         processorRef = &processor;
         controller = &c;
         apvts = &parameters;
         apvtsNA = &parametersNA;
+        dispatcherRef = &dispatcher;
+        applyTask = dispatcher.addTask([this]() { controller->applyPendingChanges(); });
+        halfRMSTask = dispatcher.addTask([this]() {
+            auto *para = apvts->getParameter(zldsp::rms::ID);
+            para->beginChangeGesture();
+            para->setValueNotifyingHost(zldsp::rms::range.convertTo0to1(halfRMSValue.load()));
+            para->endChangeGesture();
+        });
     }
 
     template<typename FloatType>
@@ -58,11 +67,12 @@ namespace zlcontroller {
             controller->setRMSSize(zldsp::rms::formatV(v));
         } else if (parameterID == zldsp::lookahead::ID) {
             controller->setLookAhead(zldsp::lookahead::formatV(v));
-            if (static_cast<int>(*apvtsNA->getRawParameterValue(zlstate::programIdx::ID)) == zlstate::preset::halfRMS) {
-                apvts->getParameter(zldsp::rms::ID)->beginChangeGesture();
-                apvts->getParameter(zldsp::rms::ID)
-                        ->setValueNotifyingHost(zldsp::rms::range.convertTo0to1(static_cast<float>(v * 2)));
-                apvts->getParameter(zldsp::rms::ID)->endChangeGesture();
+            // only the attach of the current precision drives the dependent parameter
+            const auto isActive = processorRef->isUsingDoublePrecision() == std::is_same_v<FloatType, double>;
+            const auto program = static_cast<int>(*apvtsNA->getRawParameterValue(zlstate::programIdx::ID));
+            if (isActive && program == zlstate::preset::halfRMS) {
+                halfRMSValue.store(static_cast<float>(v * 2));
+                dispatcherRef->post(halfRMSTask);
             }
         } else if (parameterID == zldsp::segment::ID) {
             controller->setSegment(zldsp::segment::formatV(v));
@@ -76,6 +86,33 @@ namespace zlcontroller {
             controller->setSideGain(v);
         } else if (parameterID == zldsp::link::ID) {
             controller->setLink(zldsp::link::formatV(v));
+        } else if (parameterID == zldsp::linkGroup::ID) {
+            controller->setLinkGroupID(static_cast<size_t>(v));
+        } else if (parameterID == zldsp::bandNum::ID) {
+            controller->setBandNum(static_cast<size_t>(v));
+        } else if (parameterID == zldsp::crossover1::ID) {
+            controller->setCrossoverFreq(0, v);
+        } else if (parameterID == zldsp::crossover2::ID) {
+            controller->setCrossoverFreq(1, v);
+        } else if (parameterID == zldsp::crossover3::ID) {
+            controller->setCrossoverFreq(2, v);
+        } else if (parameterID == zldsp::crossover4::ID) {
+            controller->setCrossoverFreq(3, v);
+        } else if (parameterID == zldsp::silenceFloor::ID) {
+            controller->setSilenceFloor(v);
+        } else if (parameterID == zldsp::midSide::ID) {
+            controller->setMidSide(static_cast<bool>(v));
+        } else if (parameterID == zldsp::lookaheadHold::ID) {
+            controller->setLookaheadHold(static_cast<bool>(v));
+        }
+        if (controller->hasPendingChanges()) {
+            // on the message thread the change is applied right away, so that the next block sees it
+            // other threads may be the audio thread, which never takes the callback lock
+            if (juce::MessageManager::existsAndIsCurrentThread()) {
+                controller->applyPendingChanges();
+            } else {
+                dispatcherRef->post(applyTask);
+            }
         }
     }
 
@@ -15,6 +15,7 @@
 #include <juce_dsp/juce_dsp.h>
 #include "dsp_definitions.h"
 #include "controller.h"
+#include "dispatcher.h"
 #include "../State/state_definitions.h"
 
 
@@ -25,7 +26,8 @@ namespace zlcontroller {
         explicit ControllerAttach(juce::AudioProcessor &processor,
                                   Controller<FloatType> &c,
                                   juce::AudioProcessorValueTreeState &parameters,
-                                  juce::AudioProcessorValueTreeState &state_parameters);
+                                  juce::AudioProcessorValueTreeState &state_parameters,
+                                  Dispatcher &dispatcher);
 
         ~ControllerAttach() override;
 
@@ -39,13 +41,24 @@ namespace zlcontroller {
         juce::AudioProcessor *processorRef;
         Controller<FloatType> *controller;
         juce::AudioProcessorValueTreeState *apvts, *apvtsNA;
+        // halfRMS preset: rms follows the lookahead, the host is notified on the message thread
+        Dispatcher *dispatcherRef;
+        // settings which reconfigure the chain and change off the message thread are applied by the dispatcher
+        size_t applyTask;
+        size_t halfRMSTask;
+        std::atomic<float> halfRMSValue{0};
         constexpr const static std::array IDs{zldsp::outGain::ID, zldsp::mix::ID,
                                               zldsp::overSample::ID,
                                               zldsp::rms::ID, zldsp::lookahead::ID,
                                               zldsp::segment::ID,
                                               zldsp::audit::ID, zldsp::external::ID,
                                               zldsp::sideGain::ID, zldsp::link::ID,
-                                              zldsp::byPass::ID, zldsp::sStyle::ID};
+                                              zldsp::byPass::ID, zldsp::sStyle::ID,
+                                              zldsp::linkGroup::ID, zldsp::bandNum::ID,
+                                              zldsp::crossover1::ID, zldsp::crossover2::ID,
+                                              zldsp::crossover3::ID, zldsp::crossover4::ID,
+                                              zldsp::silenceFloor::ID, zldsp::midSide::ID,
+                                              zldsp::lookaheadHold::ID};
 
         constexpr const static std::array defaultVs{zldsp::outGain::defaultV, zldsp::mix::defaultV,
                                                     float(zldsp::overSample::defaultI),
@@ -54,7 +67,14 @@ namespace zlcontroller {
                                                     float(zldsp::audit::defaultV), float(zldsp::external::defaultV),
                                                     zldsp::sideGain::defaultV, zldsp::link::defaultV,
                                                     float(zldsp::byPass::defaultV),
-                                                    float(zldsp::sStyle::defaultI)};
+                                                    float(zldsp::sStyle::defaultI),
+                                                    float(zldsp::linkGroup::defaultI),
+                                                    float(zldsp::bandNum::defaultI),
+                                                    zldsp::crossover1::defaultV, zldsp::crossover2::defaultV,
+                                                    zldsp::crossover3::defaultV, zldsp::crossover4::defaultV,
+                                                    zldsp::silenceFloor::defaultV,
+                                                    float(zldsp::midSide::defaultV),
+                                                    float(zldsp::lookaheadHold::defaultV)};
     };
 }
 
@@ -13,10 +13,17 @@
 namespace zlcontroller {
     template<typename FloatType>
     DetectorAttach<FloatType>::DetectorAttach(Controller<FloatType> &c,
-                                              juce::AudioProcessorValueTreeState &parameters) {
+                                              juce::AudioProcessorValueTreeState &parameters,
+                                              Dispatcher &dispatcher) {
         controller = &c;
         apvts = &parameters;
         isPlotReady.setValue(false);
+        dispatcherRef = &dispatcher;
+        plotTask = dispatcher.addTask([this]() { isPlotReady.setValue(!isPlotReady.getValue()); });
+        for (size_t band = 1; band < zldsp::maxBandNum; ++band) {
+            bandIDs[band - 1] = {zldsp::bandParameters::getID(band, zldsp::bandParameters::attackIdx),
+                                 zldsp::bandParameters::getID(band, zldsp::bandParameters::releaseIdx)};
+        }
     }
 
     template<typename FloatType>
@@ -24,6 +31,11 @@ namespace zlcontroller {
         for (auto &ID: IDs) {
             apvts->removeParameterListener(ID, this);
         }
+        for (auto &ids: bandIDs) {
+            for (auto &ID: ids) {
+                apvts->removeParameterListener(ID, this);
+            }
+        }
     }
 
     template<typename FloatType>
@@ -31,6 +43,10 @@ namespace zlcontroller {
         for (size_t i = 0; i < IDs.size(); ++i) {
             parameterChanged(IDs[i], defaultVs[i]);
         }
+        for (auto &ids: bandIDs) {
+            parameterChanged(ids[0], zldsp::attack::defaultV);
+            parameterChanged(ids[1], zldsp::release::defaultV);
+        }
     }
 
     template<typename FloatType>
@@ -38,36 +54,50 @@ namespace zlcontroller {
         for (auto &ID: IDs) {
             apvts->addParameterListener(ID, this);
         }
+        for (auto &ids: bandIDs) {
+            for (auto &ID: ids) {
+                apvts->addParameterListener(ID, this);
+            }
+        }
     }
 
     template<typename FloatType>
     void DetectorAttach<FloatType>::parameterChanged(const juce::String &parameterID, float newValue) {
         auto v = static_cast<FloatType>(newValue);
         if (parameterID == zldsp::attack::ID) {
-            controller->lDetector.setAttack(zldsp::attack::formatV(v));
-            controller->rDetector.setAttack(zldsp::attack::formatV(v));
+            controller->detectors[0].setAttack(zldsp::attack::formatV(v));
         } else if (parameterID == zldsp::release::ID) {
-            controller->lDetector.setRelease(zldsp::release::formatV(v));
-            controller->rDetector.setRelease(zldsp::release::formatV(v));
+            controller->detectors[0].setRelease(zldsp::release::formatV(v));
+        } else if (parameterID.startsWith("band")) {
+            for (size_t band = 1; band < zldsp::maxBandNum; ++band) {
+                if (parameterID == bandIDs[band - 1][0]) {
+                    controller->detectors[band].setAttack(zldsp::attack::formatV(v));
+                } else if (parameterID == bandIDs[band - 1][1]) {
+                    controller->detectors[band].setRelease(zldsp::release::formatV(v));
+                }
+            }
         } else if (parameterID == zldsp::aStyle::ID) {
             auto idx = static_cast<size_t>(v);
-            controller->lDetector.setAStyle(idx);
-            controller->rDetector.setAStyle(idx);
+            for (auto &detector: controller->detectors) {
+                detector.setAStyle(idx);
+            }
         } else if (parameterID == zldsp::rStyle::ID) {
             auto idx = static_cast<size_t>(v);
-            controller->lDetector.setRStyle(idx);
-            controller->rDetector.setRStyle(idx);
+            for (auto &detector: controller->detectors) {
+                detector.setRStyle(idx);
+            }
         } else if (parameterID == zldsp::smooth::ID) {
-            controller->lDetector.setSmooth(v);
-            controller->rDetector.setSmooth(v);
+            for (auto &detector: controller->detectors) {
+                detector.setSmooth(v);
+            }
         }
-        isPlotReady.setValue(!isPlotReady.getValue());
+        dispatcherRef->post(plotTask);
     }
 
     template<typename FloatType>
     void DetectorAttach<FloatType>::getPlotArray(std::vector<float> &x, std::vector<float> &y,
                                                  FloatType target) {
-        auto tempDetector = zldetector::Detector<FloatType>(controller->lDetector);
+        auto tempDetector = zldetector::Detector<FloatType>(controller->detectors[0]);
         auto x0 = FloatType(0), y0 = FloatType(1);
         // calculate attack plot
         FloatType deltaT = tempDetector.getAttack() / 50;
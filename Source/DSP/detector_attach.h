@@ -15,6 +15,7 @@
 #include <juce_dsp/juce_dsp.h>
 #include "dsp_definitions.h"
 #include "controller.h"
+#include "dispatcher.h"
 
 namespace zlcontroller {
     template<typename FloatType>
@@ -24,7 +25,8 @@ namespace zlcontroller {
         juce::Value isPlotReady;
 
         explicit DetectorAttach(Controller<FloatType> &c,
-                                juce::AudioProcessorValueTreeState &parameters);
+                                juce::AudioProcessorValueTreeState &parameters,
+                                Dispatcher &dispatcher);
 
         ~DetectorAttach() override;
 
@@ -39,6 +41,11 @@ namespace zlcontroller {
     private:
         Controller<FloatType> *controller;
         juce::AudioProcessorValueTreeState *apvts;
+        // the plot is invalidated on the message thread
+        Dispatcher *dispatcherRef;
+        size_t plotTask;
+        // attack and release of the first band are global, each later band has its own
+        std::array<std::array<juce::String, 2>, zldsp::maxBandNum - 1> bandIDs;
         constexpr const static std::array IDs{zldsp::attack::ID, zldsp::release::ID,
                                               zldsp::aStyle::ID, zldsp::rStyle::ID,
                                               zldsp::smooth::ID};
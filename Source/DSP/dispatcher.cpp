@@ -0,0 +1,42 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+
+#include "dispatcher.h"
+
+namespace zlcontroller {
+    Dispatcher::Dispatcher() {
+        tasks.reserve(maxTaskNum);
+        startTimerHz(dispatchHz);
+    }
+
+    Dispatcher::~Dispatcher() {
+        stopTimer();
+    }
+
+    size_t Dispatcher::addTask(std::function<void()> task) {
+        jassert(tasks.size() < maxTaskNum);
+        tasks.push_back(std::move(task));
+        return tasks.size() - 1;
+    }
+
+    void Dispatcher::flush() {
+        auto flags = pending.exchange(0, std::memory_order_acquire);
+        for (size_t idx = 0; flags != 0; ++idx, flags >>= 1) {
+            if (flags & 1) {
+                tasks[idx]();
+            }
+        }
+    }
+
+    void Dispatcher::timerCallback() {
+        flush();
+    }
+} // zlcontroller
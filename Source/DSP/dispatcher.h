@@ -0,0 +1,57 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+
+#ifndef ZLECOMP_DISPATCHER_H
+#define ZLECOMP_DISPATCHER_H
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+namespace zlcontroller {
+
+    /**
+     * defers the derived work of parameter changes (plot invalidation, dependent parameters) to the message thread
+     * post() may be called from any thread (including the audio thread), it is wait-free and does not allocate
+     * the posted tasks are run by a timer on the message thread, each task at most once per tick
+     */
+    class Dispatcher : private juce::Timer {
+    public:
+        auto static constexpr dispatchHz = 60;
+        auto static constexpr maxTaskNum = 64;
+
+        Dispatcher();
+
+        ~Dispatcher() override;
+
+        /**
+         * register a task, only call it on the message thread before any post
+         * @return the index of the task
+         */
+        size_t addTask(std::function<void()> task);
+
+        inline void post(size_t idx) noexcept {
+            pending.fetch_or(juce::uint64(1) << idx, std::memory_order_release);
+        }
+
+        /**
+         * run all pending tasks on the calling (message) thread
+         */
+        void flush();
+
+    private:
+        std::vector<std::function<void()>> tasks;
+        std::atomic<juce::uint64> pending{0};
+
+        void timerCallback() override;
+    };
+
+} // zlcontroller
+
+#endif //ZLECOMP_DISPATCHER_H
@@ -19,6 +19,35 @@ namespace zldsp {
     // float
     inline auto static const versionHint = 1;
 
+    // with ZL_MIXED_PRECISION, long-lived states (detectors, rms sums) are kept in double for float audio
+#if ZL_MIXED_PRECISION
+    template<typename FloatType>
+    using StateType = double;
+#else
+    template<typename FloatType>
+    using StateType = FloatType;
+#endif
+
+    // the largest main bus the controller can handle (7.1.4)
+    inline auto static constexpr maxChannelNum = 12;
+    // the largest number of bands in multiband mode
+    inline auto static constexpr maxBandNum = 5;
+    // the number of stored states the morph control interpolates between
+    inline auto static constexpr maxMorphSlotNum = 4;
+    // states written by different threads are aligned to separate cache lines to avoid false sharing
+    inline auto static constexpr cacheLineSize = size_t(64);
+
+    /**
+     * byte offsets of the parameter group and the state group of an object, for the layout report
+     */
+    struct Layout {
+        size_t parameterBegin, parameterEnd, stateBegin, size;
+    };
+
+    inline size_t getOffset(const void *object, const void *member) {
+        return static_cast<size_t>(static_cast<const char *>(member) - static_cast<const char *>(object));
+    }
+
     template<class T>
     class FloatParameters {
     public:
@@ -205,6 +234,114 @@ namespace zldsp {
         inline static double formatV(double x) { return x * .001; }
     };
 
+    class crossover1 : public FloatParameters<crossover1> {
+    public:
+        auto static constexpr ID = "crossover1";
+        auto static constexpr name = "Crossover 1 (Hz)";
+        inline auto static const range =
+                juce::NormalisableRange<float>(20.f, 20000.f, .1f, 0.2f);
+        auto static constexpr defaultV = 100.f;
+    };
+
+    class crossover2 : public FloatParameters<crossover2> {
+    public:
+        auto static constexpr ID = "crossover2";
+        auto static constexpr name = "Crossover 2 (Hz)";
+        inline auto static const range =
+                juce::NormalisableRange<float>(20.f, 20000.f, .1f, 0.2f);
+        auto static constexpr defaultV = 500.f;
+    };
+
+    class crossover3 : public FloatParameters<crossover3> {
+    public:
+        auto static constexpr ID = "crossover3";
+        auto static constexpr name = "Crossover 3 (Hz)";
+        inline auto static const range =
+                juce::NormalisableRange<float>(20.f, 20000.f, .1f, 0.2f);
+        auto static constexpr defaultV = 2000.f;
+    };
+
+    class crossover4 : public FloatParameters<crossover4> {
+    public:
+        auto static constexpr ID = "crossover4";
+        auto static constexpr name = "Crossover 4 (Hz)";
+        inline auto static const range =
+                juce::NormalisableRange<float>(20.f, 20000.f, .1f, 0.2f);
+        auto static constexpr defaultV = 8000.f;
+    };
+
+    class silenceFloor : public FloatParameters<silenceFloor> {
+    public:
+        auto static constexpr ID = "silence_floor";
+        auto static constexpr name = "Silence Floor (dB)";
+        inline auto static const range =
+                juce::NormalisableRange<float>(-160.f, -60.f, 1.f);
+        auto static constexpr defaultV = -120.f;
+    };
+
+    class sideHPFFreq : public FloatParameters<sideHPFFreq> {
+    public:
+        auto static constexpr ID = "side_hpf_freq";
+        auto static constexpr name = "Side HPF (Hz)";
+        inline auto static const range =
+                juce::NormalisableRange<float>(20.f, 2000.f, .1f, 0.3f);
+        auto static constexpr defaultV = 100.f;
+    };
+
+    class sideLPFFreq : public FloatParameters<sideLPFFreq> {
+    public:
+        auto static constexpr ID = "side_lpf_freq";
+        auto static constexpr name = "Side LPF (Hz)";
+        inline auto static const range =
+                juce::NormalisableRange<float>(1000.f, 20000.f, .1f, 0.3f);
+        auto static constexpr defaultV = 10000.f;
+    };
+
+    class sideTilt : public FloatParameters<sideTilt> {
+    public:
+        auto static constexpr ID = "side_tilt";
+        auto static constexpr name = "Side Tilt (dB)";
+        inline auto static const range =
+                juce::NormalisableRange<float>(-12.f, 12.f, .01f);
+        auto static constexpr defaultV = 0.f;
+    };
+
+    class sidePeakFreq : public FloatParameters<sidePeakFreq> {
+    public:
+        auto static constexpr ID = "side_peak_freq";
+        auto static constexpr name = "Side Peak (Hz)";
+        inline auto static const range =
+                juce::NormalisableRange<float>(20.f, 20000.f, .1f, 0.2f);
+        auto static constexpr defaultV = 1000.f;
+    };
+
+    class sidePeakGain : public FloatParameters<sidePeakGain> {
+    public:
+        auto static constexpr ID = "side_peak_gain";
+        auto static constexpr name = "Side Peak Gain (dB)";
+        inline auto static const range =
+                juce::NormalisableRange<float>(-18.f, 18.f, .01f);
+        auto static constexpr defaultV = 0.f;
+    };
+
+    class sidePeakQ : public FloatParameters<sidePeakQ> {
+    public:
+        auto static constexpr ID = "side_peak_q";
+        auto static constexpr name = "Side Peak Q";
+        inline auto static const range =
+                juce::NormalisableRange<float>(0.1f, 10.f, .01f, 0.5f);
+        auto static constexpr defaultV = 0.707f;
+    };
+
+    class morph : public FloatParameters<morph> {
+    public:
+        auto static constexpr ID = "morph";
+        auto static constexpr name = "Morph";
+        inline auto static const range =
+                juce::NormalisableRange<float>(0.f, float(maxMorphSlotNum - 1), .01f);
+        auto static constexpr defaultV = 0.f;
+    };
+
     // bool
     template<class T>
     class BoolParameters {
@@ -230,6 +367,41 @@ namespace zldsp {
         auto static constexpr defaultV = false;
     };
 
+    class sideHPF : public BoolParameters<sideHPF> {
+    public:
+        auto static constexpr ID = "side_hpf";
+        auto static constexpr name = "Side HPF";
+        auto static constexpr defaultV = false;
+    };
+
+    class sideLPF : public BoolParameters<sideLPF> {
+    public:
+        auto static constexpr ID = "side_lpf";
+        auto static constexpr name = "Side LPF";
+        auto static constexpr defaultV = false;
+    };
+
+    class lookaheadHold : public BoolParameters<lookaheadHold> {
+    public:
+        auto static constexpr ID = "lookahead_hold";
+        auto static constexpr name = "Lookahead Hold";
+        auto static constexpr defaultV = false;
+    };
+
+    class midSide : public BoolParameters<midSide> {
+    public:
+        auto static constexpr ID = "mid_side";
+        auto static constexpr name = "Mid/Side";
+        auto static constexpr defaultV = false;
+    };
+
+    class morphOn : public BoolParameters<morphOn> {
+    public:
+        auto static constexpr ID = "morph_on";
+        auto static constexpr name = "Morph ON";
+        auto static constexpr defaultV = false;
+    };
+
     class byPass : public BoolParameters<byPass> {
     public:
         auto static constexpr ID = "byPass";
@@ -281,6 +453,30 @@ namespace zldsp {
         };
     };
 
+    class linkGroup : public ChoiceParameters<linkGroup> {
+    public:
+        auto static constexpr ID = "link_group";
+        auto static constexpr name = "Link Group";
+        inline auto static const choices = juce::StringArray{"All", "No LFE", "Pairs"};
+        int static constexpr defaultI = 0;
+        enum {
+            all, noLFE, pairs, linkGroupNUM
+        };
+    };
+
+    class bandNum : public ChoiceParameters<bandNum> {
+    public:
+        auto static constexpr ID = "band_num";
+        auto static constexpr name = "Bands";
+        inline auto static const choices = juce::StringArray{"OFF", "2", "3", "4", "5"};
+        int static constexpr defaultI = 0;
+        enum {
+            off, b2, b3, b4, b5, bandNUM
+        };
+
+        inline static size_t getBandNum(size_t idx) { return idx == off ? 1 : idx + 1; }
+    };
+
     class overSample : public ChoiceParameters<overSample> {
     public:
         auto static constexpr ID = "over_sample";
@@ -292,6 +488,98 @@ namespace zldsp {
         };
     };
 
+    /**
+     * the computer parameters stored in each morph slot
+     * they are not automatable and live in the NA parameters, so they are saved with the plugin state
+     */
+    class morphSlot {
+    public:
+        constexpr const static std::array IDs{threshold::ID, ratio::ID, kneeW::ID,
+                                              kneeD::ID, kneeS::ID, bound::ID};
+        constexpr const static std::array defaultVs{threshold::defaultV, ratio::defaultV, kneeW::defaultV,
+                                                    kneeD::defaultV, kneeS::defaultV, bound::defaultV};
+        enum {
+            thresholdIdx, ratioIdx, kneeWIdx, kneeDIdx, kneeSIdx, boundIdx, paraNUM
+        };
+
+        inline static juce::String getID(size_t slot, size_t idx) {
+            return "morph" + juce::String(slot) + "_" + IDs[idx];
+        }
+
+        inline static const juce::NormalisableRange<float> &getRange(size_t idx) {
+            switch (idx) {
+                case ratioIdx: return ratio::range;
+                case kneeWIdx: return kneeW::range;
+                case kneeDIdx: return kneeD::range;
+                case kneeSIdx: return kneeS::range;
+                case boundIdx: return bound::range;
+                default: return threshold::range;
+            }
+        }
+
+        static void addToLayout(juce::AudioProcessorValueTreeState::ParameterLayout &layout) {
+            for (size_t slot = 0; slot < maxMorphSlotNum; ++slot) {
+                for (size_t idx = 0; idx < paraNUM; ++idx) {
+                    auto attributes = juce::AudioParameterFloatAttributes().withAutomatable(false).withLabel("NA");
+                    layout.add(std::make_unique<juce::AudioParameterFloat>(
+                            juce::ParameterID(getID(slot, idx), versionHint), "NA",
+                            getRange(idx), defaultVs[idx], attributes));
+                }
+            }
+        }
+    };
+
+    /**
+     * the computer and detector parameters of each band after the first in multiband mode
+     * the first band uses the global parameters, so single band mode and the morph slots are unchanged
+     */
+    class bandParameters {
+    public:
+        // the computer parameters come first, in the order of the morph slots
+        constexpr const static std::array IDs{threshold::ID, ratio::ID, kneeW::ID,
+                                              kneeD::ID, kneeS::ID, bound::ID,
+                                              attack::ID, release::ID};
+        constexpr const static std::array names{threshold::name, ratio::name, kneeW::name,
+                                                kneeD::name, kneeS::name, bound::name,
+                                                attack::name, release::name};
+        constexpr const static std::array defaultVs{threshold::defaultV, ratio::defaultV, kneeW::defaultV,
+                                                    kneeD::defaultV, kneeS::defaultV, bound::defaultV,
+                                                    attack::defaultV, release::defaultV};
+        enum {
+            thresholdIdx, ratioIdx, kneeWIdx, kneeDIdx, kneeSIdx, boundIdx, attackIdx, releaseIdx, paraNUM
+        };
+        static constexpr size_t computerParaNUM = attackIdx;
+
+        inline static juce::String getID(size_t band, size_t idx) {
+            return "band" + juce::String(band + 1) + "_" + IDs[idx];
+        }
+
+        inline static const juce::NormalisableRange<float> &getRange(size_t idx) {
+            switch (idx) {
+                case ratioIdx: return ratio::range;
+                case kneeWIdx: return kneeW::range;
+                case kneeDIdx: return kneeD::range;
+                case kneeSIdx: return kneeS::range;
+                case boundIdx: return bound::range;
+                case attackIdx: return attack::range;
+                case releaseIdx: return release::range;
+                default: return threshold::range;
+            }
+        }
+
+        static void addToLayout(juce::AudioProcessorValueTreeState::ParameterLayout &layout) {
+            for (size_t band = 1; band < maxBandNum; ++band) {
+                for (size_t idx = 0; idx < paraNUM; ++idx) {
+                    const auto name = "Band " + juce::String(band + 1) + " " + names[idx];
+                    auto attributes = juce::AudioParameterFloatAttributes().withAutomatable(true).withLabel(name);
+                    layout.add(std::make_unique<juce::AudioParameterFloat>(
+                            juce::ParameterID(getID(band, idx), versionHint), name,
+                            getRange(idx), defaultVs[idx], attributes));
+                }
+            }
+        }
+    };
+
     inline juce::AudioProcessorValueTreeState::ParameterLayout getParameterLayout() {
         juce::AudioProcessorValueTreeState::ParameterLayout layout;
         layout.add(threshold::get(), ratio::get(), kneeW::get(),
@@ -306,7 +594,22 @@ namespace zldsp {
                    rms::get(), lookahead::get(),
                    overSample::get(),
 
-                   byPass::get(), sStyle::get());
+                   byPass::get(), sStyle::get(),
+
+                   linkGroup::get(),
+
+                   bandNum::get(), crossover1::get(), crossover2::get(),
+                   crossover3::get(), crossover4::get(),
+
+                   silenceFloor::get(),
+
+                   sideHPF::get(), sideHPFFreq::get(), sideLPF::get(), sideLPFFreq::get(),
+                   sideTilt::get(), sidePeakFreq::get(), sidePeakGain::get(), sidePeakQ::get(),
+
+                   midSide::get(), lookaheadHold::get(),
+
+                   morphOn::get(), morph::get());
+        bandParameters::addToLayout(layout);
         return layout;
     }
 
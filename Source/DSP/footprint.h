@@ -0,0 +1,55 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#ifndef ZLECOMP_FOOTPRINT_H
+#define ZLECOMP_FOOTPRINT_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+
+namespace zlcontroller {
+
+    /**
+     * bytes held by each subsystem of a plugin instance
+     * the editor images are cached once per process and shared by all editors, they are reported apart
+     */
+    struct Footprint {
+        enum {
+            overSamplers, delayLines, fifos, meterHistories, blockBuffers, bandBuffers, holds,
+            parameterTrees, subsystemNUM
+        };
+
+        static constexpr std::array<const char *, subsystemNUM> names{
+                "Over-samplers", "Delay Lines", "FIFOs", "Meter Histories", "Block Buffers", "Band Buffers",
+                "Lookahead Holds", "Parameter Trees"
+        };
+
+        std::array<size_t, subsystemNUM> bytes{};
+        // not part of the total
+        size_t sharedEditorImages = 0;
+
+        inline size_t getTotal() const {
+            return std::accumulate(bytes.begin(), bytes.end(), size_t(0));
+        }
+
+        inline Footprint &operator+=(const Footprint &other) {
+            for (size_t i = 0; i < subsystemNUM; ++i) {
+                bytes[i] += other.bytes[i];
+            }
+            sharedEditorImages = std::max(sharedEditorImages, other.sharedEditorImages);
+            return *this;
+        }
+    };
+
+} // zlcontroller
+
+#endif //ZLECOMP_FOOTPRINT_H
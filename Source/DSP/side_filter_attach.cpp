@@ -0,0 +1,71 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include "side_filter_attach.h"
+
+namespace zlcontroller {
+    template<typename FloatType>
+    SideFilterAttach<FloatType>::SideFilterAttach(juce::AudioProcessor &processor,
+                                                  Controller<FloatType> &control,
+                                                  juce::AudioProcessorValueTreeState &parameters) {
+        processorRef = &processor;
+        c = &control;
+        apvts = &parameters;
+    }
+
+    template<typename FloatType>
+    SideFilterAttach<FloatType>::~SideFilterAttach() {
+        for (auto &ID: IDs) {
+            apvts->removeParameterListener(ID, this);
+        }
+    }
+
+    template<typename FloatType>
+    void SideFilterAttach<FloatType>::initDefaultVs() {
+        for (size_t i = 0; i < IDs.size(); ++i) {
+            parameterChanged(IDs[i], defaultVs[i]);
+        }
+    }
+
+    template<typename FloatType>
+    void SideFilterAttach<FloatType>::addListeners() {
+        for (auto &ID: IDs) {
+            apvts->addParameterListener(ID, this);
+        }
+    }
+
+    template<typename FloatType>
+    void SideFilterAttach<FloatType>::parameterChanged(const juce::String &parameterID, float newValue) {
+        auto v = static_cast<FloatType>(newValue);
+        if (parameterID == zldsp::sideHPF::ID) {
+            c->sideFilter.setHPF(static_cast<bool>(v));
+        } else if (parameterID == zldsp::sideHPFFreq::ID) {
+            c->sideFilter.setHPFFreq(v);
+        } else if (parameterID == zldsp::sideLPF::ID) {
+            c->sideFilter.setLPF(static_cast<bool>(v));
+        } else if (parameterID == zldsp::sideLPFFreq::ID) {
+            c->sideFilter.setLPFFreq(v);
+        } else if (parameterID == zldsp::sideTilt::ID) {
+            c->sideFilter.setTilt(v);
+        } else if (parameterID == zldsp::sidePeakFreq::ID) {
+            c->sideFilter.setPeakFreq(v);
+        } else if (parameterID == zldsp::sidePeakGain::ID) {
+            c->sideFilter.setPeakGain(v);
+        } else if (parameterID == zldsp::sidePeakQ::ID) {
+            c->sideFilter.setPeakQ(v);
+        }
+    }
+
+    template
+    class SideFilterAttach<float>;
+
+    template
+    class SideFilterAttach<double>;
+}
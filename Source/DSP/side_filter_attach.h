@@ -0,0 +1,53 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#ifndef ZLECOMP_SIDE_FILTER_ATTACH_H
+#define ZLECOMP_SIDE_FILTER_ATTACH_H
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include "dsp_definitions.h"
+#include "controller.h"
+
+namespace zlcontroller {
+    template<typename FloatType>
+    class SideFilterAttach : public juce::AudioProcessorValueTreeState::Listener {
+    public:
+        explicit SideFilterAttach(juce::AudioProcessor &processor,
+                                  Controller<FloatType> &control,
+                                  juce::AudioProcessorValueTreeState &parameters);
+
+        ~SideFilterAttach() override;
+
+        void initDefaultVs();
+
+        void addListeners();
+
+        void parameterChanged(const juce::String &parameterID, float newValue) override;
+
+    private:
+        juce::AudioProcessor *processorRef;
+        Controller<FloatType> *c;
+        juce::AudioProcessorValueTreeState *apvts;
+        constexpr const static std::array IDs{zldsp::sideHPF::ID, zldsp::sideHPFFreq::ID,
+                                              zldsp::sideLPF::ID, zldsp::sideLPFFreq::ID,
+                                              zldsp::sideTilt::ID,
+                                              zldsp::sidePeakFreq::ID, zldsp::sidePeakGain::ID,
+                                              zldsp::sidePeakQ::ID};
+
+        constexpr const static std::array defaultVs{float(zldsp::sideHPF::defaultV), zldsp::sideHPFFreq::defaultV,
+                                                    float(zldsp::sideLPF::defaultV), zldsp::sideLPFFreq::defaultV,
+                                                    zldsp::sideTilt::defaultV,
+                                                    zldsp::sidePeakFreq::defaultV, zldsp::sidePeakGain::defaultV,
+                                                    zldsp::sidePeakQ::defaultV};
+    };
+}
+
+#endif //ZLECOMP_SIDE_FILTER_ATTACH_H
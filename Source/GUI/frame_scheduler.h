@@ -0,0 +1,115 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+
+#ifndef ZL_FRAME_SCHEDULER_H
+#define ZL_FRAME_SCHEDULER_H
+
+#include "juce_gui_basics/juce_gui_basics.h"
+
+namespace zlinterface {
+
+    /**
+     * one vblank-driven frame clock for the whole editor
+     * each frame, all clients poll their sources once and mark the areas they need to redraw
+     * the dirty areas are merged and repainted together at the end of the frame
+     * the frame rate drops when the editor is hidden/minimised or nothing has changed for a while
+     */
+    class FrameScheduler {
+    public:
+        class Client {
+        public:
+            virtual ~Client() = default;
+
+            /**
+             * poll the sources of this client and mark dirty areas
+             * @param deltaTime seconds since the last polled frame
+             */
+            virtual void onFrame(FrameScheduler &scheduler, double deltaTime) = 0;
+        };
+
+        // idle: no dirty area for this many seconds
+        auto static constexpr idleSeconds = 0.5, idleFreqHz = 15.0, hiddenFreqHz = 2.0;
+
+        FrameScheduler() = default;
+
+        ~FrameScheduler() { detach(); }
+
+        void attach(juce::Component &component) {
+            root = &component;
+            lastFrameTime = juce::Time::getMillisecondCounterHiRes() * 0.001;
+            vBlankAttachment = std::make_unique<juce::VBlankAttachment>(root, [this] { onVBlank(); });
+        }
+
+        void detach() {
+            vBlankAttachment.reset();
+            root = nullptr;
+        }
+
+        void addClient(Client *client) {
+            clients.addIfNotAlreadyThere(client);
+        }
+
+        void removeClient(Client *client) {
+            clients.removeFirstMatchingValue(client);
+        }
+
+        /**
+         * mark an area of a component as dirty, it will be repainted at the end of the current frame
+         */
+        void markDirty(juce::Component &component, juce::Rectangle<int> area) {
+            if (root == nullptr) {
+                component.repaint(area);
+            } else if (&component == root || root->isParentOf(&component)) {
+                dirtyArea.add(root->getLocalArea(&component, area));
+            }
+        }
+
+        void markDirty(juce::Component &component) {
+            markDirty(component, component.getLocalBounds());
+        }
+
+    private:
+        juce::Component *root = nullptr;
+        std::unique_ptr<juce::VBlankAttachment> vBlankAttachment;
+        juce::Array<Client *> clients;
+        juce::RectangleList<int> dirtyArea;
+        double lastFrameTime = 0, lastDirtyTime = 0;
+
+        void onVBlank() {
+            const auto currentTime = juce::Time::getMillisecondCounterHiRes() * 0.001;
+            const auto deltaTime = currentTime - lastFrameTime;
+            // throttle the frame rate when hidden/minimised or idle
+            const auto *peer = root->getPeer();
+            if (!root->isShowing() || peer == nullptr || peer->isMinimised()) {
+                if (deltaTime < 1.0 / hiddenFreqHz) {
+                    return;
+                }
+            } else if (currentTime - lastDirtyTime > idleSeconds && deltaTime < 1.0 / idleFreqHz) {
+                return;
+            }
+            lastFrameTime = currentTime;
+
+            for (auto *client: clients) {
+                client->onFrame(*this, deltaTime);
+            }
+            if (!dirtyArea.isEmpty()) {
+                lastDirtyTime = currentTime;
+                dirtyArea.consolidate();
+                for (const auto &area: dirtyArea) {
+                    root->repaint(area);
+                }
+                dirtyArea.clear();
+            }
+        }
+    };
+}
+
+#endif //ZL_FRAME_SCHEDULER_H
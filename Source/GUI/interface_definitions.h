@@ -12,6 +12,8 @@
 #define ZL_INTERFACE_DEFINES_H
 
 #include "juce_gui_basics/juce_gui_basics.h"
+#include "frame_scheduler.h"
+#include "shadow_cache.h"
 
 namespace zlinterface {
 
@@ -76,10 +78,10 @@ namespace zlinterface {
                 boxBounds.getHeight() - static_cast<float>(radius) - 1.42f * cornerSize);
     }
 
-    inline juce::Rectangle<float> fillRoundedShadowRectangle(juce::Graphics &g,
-                                                             juce::Rectangle<float> boxBounds,
-                                                             float cornerSize,
-                                                             const fillRoundedShadowRectangleArgs &args) {
+    inline juce::Rectangle<float> renderRoundedShadowRectangle(juce::Graphics &g,
+                                                               juce::Rectangle<float> boxBounds,
+                                                               float cornerSize,
+                                                               const fillRoundedShadowRectangleArgs &args) {
         juce::Path path;
         auto radius = juce::jmax(juce::roundToInt(cornerSize * args.blurRadius * 1.5f), 1);
         if (args.fit) {
@@ -117,10 +119,10 @@ namespace zlinterface {
         return boxBounds;
     }
 
-    inline juce::Rectangle<float> fillRoundedInnerShadowRectangle(juce::Graphics &g,
-                                                                  juce::Rectangle<float> boxBounds,
-                                                                  float cornerSize,
-                                                                  const fillRoundedShadowRectangleArgs &args) {
+    inline juce::Rectangle<float> renderRoundedInnerShadowRectangle(juce::Graphics &g,
+                                                                    juce::Rectangle<float> boxBounds,
+                                                                    float cornerSize,
+                                                                    const fillRoundedShadowRectangleArgs &args) {
         juce::Path mask;
         mask.addRoundedRectangle(boxBounds.getX(), boxBounds.getY(),
                                  boxBounds.getWidth(), boxBounds.getHeight(),
@@ -175,10 +177,10 @@ namespace zlinterface {
         juce::Colour brightShadowColor = BrightShadowColor;
     };
 
-    inline juce::Rectangle<float> drawShadowEllipse(juce::Graphics &g,
-                                                    juce::Rectangle<float> boxBounds,
-                                                    float cornerSize,
-                                                    const fillShadowEllipseArgs &args) {
+    inline juce::Rectangle<float> renderShadowEllipse(juce::Graphics &g,
+                                                      juce::Rectangle<float> boxBounds,
+                                                      float cornerSize,
+                                                      const fillShadowEllipseArgs &args) {
         juce::Path path;
         auto radius = juce::jmax(juce::roundToInt(cornerSize * 0.75f), 1);
         if (args.fit) {
@@ -210,10 +212,10 @@ namespace zlinterface {
         return boxBounds;
     }
 
-    inline juce::Rectangle<float> drawInnerShadowEllipse(juce::Graphics &g,
-                                                         juce::Rectangle<float> boxBounds,
-                                                         float cornerSize,
-                                                         const fillShadowEllipseArgs &args) {
+    inline juce::Rectangle<float> renderInnerShadowEllipse(juce::Graphics &g,
+                                                           juce::Rectangle<float> boxBounds,
+                                                           float cornerSize,
+                                                           const fillShadowEllipseArgs &args) {
         juce::Path mask;
         mask.addEllipse(boxBounds);
         g.saveState();
@@ -249,6 +251,81 @@ namespace zlinterface {
         return boxBounds;
     }
 
+    inline int getShadowFlags(const fillRoundedShadowRectangleArgs &args) {
+        int flags = 0, bit = 0;
+        for (const auto f: {args.curveTopLeft, args.curveTopRight, args.curveBottomLeft, args.curveBottomRight,
+                            args.fit, args.flip, args.drawBright, args.drawDark, args.drawMain}) {
+            flags |= static_cast<int>(f) << (bit++);
+        }
+        return flags;
+    }
+
+    inline int getShadowFlags(const fillShadowEllipseArgs &args) {
+        int flags = 0, bit = 0;
+        for (const auto f: {args.fit, args.flip, args.drawBright, args.drawDark}) {
+            flags |= static_cast<int>(f) << (bit++);
+        }
+        return flags;
+    }
+
+    template<typename ArgsType>
+    inline ShadowCache::Key getShadowKey(ShadowCache::ShapeType shape, juce::Rectangle<float> boxBounds,
+                                         float cornerSize, const ArgsType &args) {
+        return {.shape = shape,
+                .width = ShadowCache::quantize(boxBounds.getWidth()),
+                .height = ShadowCache::quantize(boxBounds.getHeight()),
+                .cornerSize = ShadowCache::quantize(cornerSize),
+                .blurRadius = ShadowCache::quantize(args.blurRadius),
+                .flags = getShadowFlags(args),
+                .mainColour = args.mainColour.getARGB(),
+                .darkColour = args.darkShadowColor.getARGB(),
+                .brightColour = args.brightShadowColor.getARGB()};
+    }
+
+    // the shadows below are rendered once by the shadow cache, and composited on later paints
+
+    inline juce::Rectangle<float> fillRoundedShadowRectangle(juce::Graphics &g,
+                                                             juce::Rectangle<float> boxBounds,
+                                                             float cornerSize,
+                                                             const fillRoundedShadowRectangleArgs &args) {
+        const auto margin = cornerSize * (1.5f + 2.5f * args.blurRadius) + 2.f;
+        return ShadowCache::getInstance().draw(
+                g, getShadowKey(ShadowCache::roundedRectangle, boxBounds, cornerSize, args),
+                boxBounds.expanded(margin),
+                [&](juce::Graphics &ig) { return renderRoundedShadowRectangle(ig, boxBounds, cornerSize, args); });
+    }
+
+    inline juce::Rectangle<float> fillRoundedInnerShadowRectangle(juce::Graphics &g,
+                                                                  juce::Rectangle<float> boxBounds,
+                                                                  float cornerSize,
+                                                                  const fillRoundedShadowRectangleArgs &args) {
+        return ShadowCache::getInstance().draw(
+                g, getShadowKey(ShadowCache::innerRoundedRectangle, boxBounds, cornerSize, args),
+                boxBounds,
+                [&](juce::Graphics &ig) { return renderRoundedInnerShadowRectangle(ig, boxBounds, cornerSize, args); });
+    }
+
+    inline juce::Rectangle<float> drawShadowEllipse(juce::Graphics &g,
+                                                    juce::Rectangle<float> boxBounds,
+                                                    float cornerSize,
+                                                    const fillShadowEllipseArgs &args) {
+        const auto margin = cornerSize * (0.75f + args.blurRadius) + 2.f;
+        return ShadowCache::getInstance().draw(
+                g, getShadowKey(ShadowCache::ellipse, boxBounds, cornerSize, args),
+                boxBounds.expanded(margin),
+                [&](juce::Graphics &ig) { return renderShadowEllipse(ig, boxBounds, cornerSize, args); });
+    }
+
+    inline juce::Rectangle<float> drawInnerShadowEllipse(juce::Graphics &g,
+                                                         juce::Rectangle<float> boxBounds,
+                                                         float cornerSize,
+                                                         const fillShadowEllipseArgs &args) {
+        return ShadowCache::getInstance().draw(
+                g, getShadowKey(ShadowCache::innerEllipse, boxBounds, cornerSize, args),
+                boxBounds,
+                [&](juce::Graphics &ig) { return renderInnerShadowEllipse(ig, boxBounds, cornerSize, args); });
+    }
+
     inline std::string formatFloat(float x, int precision) {
         std::stringstream stream;
         precision = std::max(0, precision);
@@ -302,6 +379,8 @@ namespace zlinterface {
 
         inline juce::Colour getLineColor1() { return styleColors[styleID.load()].LineColor1; }
 
+        inline FrameScheduler &getFrameScheduler() { return frameScheduler; }
+
         juce::Rectangle<float> getRoundedShadowRectangleArea(juce::Rectangle<float> boxBounds,
                                                              float cornerSize,
                                                              const fillRoundedShadowRectangleArgs &args) {
@@ -355,6 +434,7 @@ namespace zlinterface {
     private:
         std::atomic<float> fontSize;
         std::atomic<size_t> styleID;
+        FrameScheduler frameScheduler;
     };
 }
 
@@ -19,28 +19,27 @@
 
 namespace zlinterface {
 
-    class MeterComponent : public juce::Component, private juce::Timer {
+    class MeterComponent : public juce::Component, private FrameScheduler::Client {
     public:
         explicit MeterComponent(const juce::String &labelText,
                                 zlmeter::MeterSource<float> *meterSource,
                                 float minV, float maxV,
                                 UIBase &base) :
                 myLookAndFeel(base), nameLookAndFeel(base) {
+            uiBase = &base;
             // set meter
             source = meterSource;
-            source->setDecayRate(27.f / zlinterface::RefreshFreqHz);
             myLookAndFeel.setRMSRange(minV, maxV);
             setLookAndFeel(&myLookAndFeel);
-            startTimerHz(zlinterface::RefreshFreqHz);
+            uiBase->getFrameScheduler().addClient(this);
             // set label
             label.setText(labelText, juce::dontSendNotification);
             label.setLookAndFeel(&nameLookAndFeel);
             addAndMakeVisible(label);
-            juce::ignoreUnused(uiBase);
         }
 
         ~MeterComponent() override {
-            stopTimer();
+            uiBase->getFrameScheduler().removeClient(this);
         }
 
         void resized() override {
@@ -49,13 +48,13 @@ namespace zlinterface {
 
         void paint(juce::Graphics &g) override {
             g.fillAll(zlinterface::BackgroundColor);
-            auto rms = source->getDisplayRMS();
-            auto peak = source->getDisplayPeak();
-            auto peakMax = source->getPeakMax();
             auto bound = getLocalBounds().toFloat();
             bound = bound.withTrimmedBottom(bound.getHeight() * 0.05f);
-            myLookAndFeel.drawMeters(g, bound, rms, peak, peakMax);
-            source->resetBuffer();
+            const auto n = snapshot.numChannels;
+            myLookAndFeel.drawMeters(g, bound,
+                                     std::span(snapshot.rms).first(n),
+                                     std::span(snapshot.peak).first(n),
+                                     std::span(snapshot.peakMax).first(n));
         }
 
         void mouseDown(const juce::MouseEvent &event) override {
@@ -67,12 +66,20 @@ namespace zlinterface {
             myLookAndFeel.setRMSRange(minV, maxV);
         }
 
-        void timerCallback() override {
-            repaint();
+        void onFrame(FrameScheduler &scheduler, double deltaTime) override {
+            // the decay follows the actual frame interval, so it does not depend on the frame rate
+            const auto &display = source->readDisplay(27.f * static_cast<float>(deltaTime));
+            if (display.numChannels != snapshot.numChannels || display.rms != snapshot.rms ||
+                display.peak != snapshot.peak || display.peakMax != snapshot.peakMax) {
+                snapshot = display;
+                scheduler.markDirty(*this);
+            }
         }
 
     private:
         zlmeter::MeterSource<float> *source = nullptr;
+        // the values drawn by the last paint
+        zlmeter::MeterSource<float>::Snapshot snapshot;
         juce::Label label;
         MeterLookAndFeel myLookAndFeel;
         NameLookAndFeel nameLookAndFeel;
@@ -11,6 +11,7 @@
 #ifndef ZLINFLATOR_METERLOOKANDFEEL_H
 #define ZLINFLATOR_METERLOOKANDFEEL_H
 
+#include <span>
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "interface_definitions.h"
 
@@ -23,9 +24,9 @@ namespace zlinterface {
         }
 
         void drawMeters(juce::Graphics &g, const juce::Rectangle<float> &bounds,
-                        const std::vector<float> &rms,
-                        const std::vector<float> &peak,
-                        const std::vector<float> &peakMax) {
+                        std::span<const float> rms,
+                        std::span<const float> peak,
+                        std::span<const float> peakMax) {
 
             auto bound = bounds.toFloat();
             bound = uiBase->fillRoundedShadowRectangle(g, bound,
@@ -0,0 +1,143 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+
+#ifndef ZL_SHADOW_CACHE_H
+#define ZL_SHADOW_CACHE_H
+
+#include "juce_gui_basics/juce_gui_basics.h"
+
+namespace zlinterface {
+
+    /**
+     * a process-wide cache of pre-rendered shadow shapes
+     * each shape is rendered once into an image (at the physical pixel scale), later paints only composite it
+     * entries are keyed by shape, size, radius, colours and flags, and evicted by least recent use
+     */
+    class ShadowCache {
+    public:
+        enum ShapeType {
+            roundedRectangle, innerRoundedRectangle, ellipse, innerEllipse
+        };
+
+        struct Key {
+            int shape = 0;
+            // sizes and the sub-pixel offset are quantized to 1/64 px
+            int width = 0, height = 0, fracX = 0, fracY = 0, cornerSize = 0, blurRadius = 0, scale = 0;
+            int flags = 0;
+            juce::uint32 mainColour = 0, darkColour = 0, brightColour = 0;
+
+            bool operator==(const Key &other) const = default;
+        };
+
+        // the total budget of cached pixels (in bytes)
+        auto static constexpr maxBytes = static_cast<size_t>(64) << 20;
+
+        static ShadowCache &getInstance() {
+            static ShadowCache cache;
+            return cache;
+        }
+
+        static int quantize(float x) { return juce::roundToInt(x * 64.f); }
+
+        /**
+         * draw a shadow shape through the cache
+         * @param area the area that the render function may draw into, in the coordinates of g
+         * @param render draws the shape into the given graphics (in the coordinates of g) and returns its bound
+         */
+        template<typename RenderFunc>
+        juce::Rectangle<float> draw(juce::Graphics &g, Key key, juce::Rectangle<float> area, RenderFunc &&render) {
+            const auto scale = juce::jlimit(1.f, 4.f, g.getInternalContext().getPhysicalPixelScaleFactor());
+            const auto origin = juce::Point<float>(std::floor(area.getX()), std::floor(area.getY()));
+            key.fracX = quantize(area.getX() - origin.x);
+            key.fracY = quantize(area.getY() - origin.y);
+            key.scale = quantize(scale);
+
+            juce::Image image;
+            juce::Rectangle<float> bound;
+            {
+                const juce::ScopedLock lock(cacheLock);
+                if (auto it = entries.find(key); it != entries.end()) {
+                    it->second.lastUse = ++useCounter;
+                    image = it->second.image;
+                    bound = it->second.bound;
+                }
+            }
+            if (!image.isValid()) {
+                const auto w = juce::jmax(1, static_cast<int>(std::ceil((area.getRight() - origin.x) * scale)));
+                const auto h = juce::jmax(1, static_cast<int>(std::ceil((area.getBottom() - origin.y) * scale)));
+                image = juce::Image(juce::Image::ARGB, w, h, true, juce::SoftwareImageType());
+                {
+                    juce::Graphics ig(image);
+                    ig.addTransform(juce::AffineTransform::translation(-origin.x, -origin.y).scaled(scale));
+                    bound = render(ig) - origin;
+                }
+                insert(key, image, bound);
+            }
+            g.drawImage(image, juce::Rectangle<float>(origin.x, origin.y,
+                                                      static_cast<float>(image.getWidth()) / scale,
+                                                      static_cast<float>(image.getHeight()) / scale));
+            return bound + origin;
+        }
+
+        size_t getTotalBytes() {
+            const juce::ScopedLock lock(cacheLock);
+            return totalBytes;
+        }
+
+    private:
+        struct KeyHash {
+            size_t operator()(const Key &k) const {
+                size_t h = 14695981039346656037ull;
+                for (const auto v: {k.shape, k.width, k.height, k.fracX, k.fracY, k.cornerSize, k.blurRadius,
+                                    k.scale, k.flags, static_cast<int>(k.mainColour),
+                                    static_cast<int>(k.darkColour), static_cast<int>(k.brightColour)}) {
+                    h = (h ^ static_cast<size_t>(static_cast<juce::uint32>(v))) * 1099511628211ull;
+                }
+                return h;
+            }
+        };
+
+        struct Entry {
+            juce::Image image;
+            juce::Rectangle<float> bound;
+            juce::uint64 lastUse = 0;
+        };
+
+        juce::CriticalSection cacheLock;
+        std::unordered_map<Key, Entry, KeyHash> entries;
+        juce::uint64 useCounter = 0;
+        size_t totalBytes = 0;
+
+        ShadowCache() = default;
+
+        static size_t getBytes(const juce::Image &image) {
+            return static_cast<size_t>(image.getWidth()) * static_cast<size_t>(image.getHeight()) * 4;
+        }
+
+        void insert(const Key &key, const juce::Image &image, juce::Rectangle<float> bound) {
+            const juce::ScopedLock lock(cacheLock);
+            if (entries.find(key) != entries.end()) {
+                return;
+            }
+            totalBytes += getBytes(image);
+            entries.emplace(key, Entry{image, bound, ++useCounter});
+            while (totalBytes > maxBytes && entries.size() > 1) {
+                auto oldest = std::min_element(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+                    return a.second.lastUse < b.second.lastUse;
+                });
+                totalBytes -= getBytes(oldest->second.image);
+                entries.erase(oldest);
+            }
+        }
+    };
+}
+
+#endif //ZL_SHADOW_CACHE_H
@@ -0,0 +1,39 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+
+#ifndef ZL_SHARED_RESOURCES_H
+#define ZL_SHARED_RESOURCES_H
+
+#include "juce_gui_basics/juce_gui_basics.h"
+#include <BinaryData.h>
+
+namespace zlinterface {
+
+    /**
+     * immutable resources shared by every editor in the host process
+     * hold it through juce::SharedResourcePointer, it is created with the first editor and freed with the last one
+     */
+    class SharedResources {
+    public:
+        SharedResources() :
+                openSansSemiBold(juce::Typeface::createSystemTypefaceFor(BinaryData::OpenSansSemiBold_ttf,
+                                                                         BinaryData::OpenSansSemiBold_ttfSize)) {}
+
+        inline juce::Typeface::Ptr getOpenSansSemiBold() const { return openSansSemiBold; }
+
+    private:
+        const juce::Typeface::Ptr openSansSemiBold;
+
+        JUCE_DECLARE_NON_COPYABLE(SharedResources)
+    };
+}
+
+#endif //ZL_SHARED_RESOURCES_H
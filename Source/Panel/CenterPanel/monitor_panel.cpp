@@ -106,9 +106,7 @@ namespace zlpanel {
         auto idx = monitorSetting.load();
         if (idx == zlstate::monitorSetting::off) {
             monitorSubPanel.setMonitorVisible(false);
-            vBlankAttachment.reset();
         } else {
-            vBlankAttachment = std::make_unique<juce::VBlankAttachment>(&monitorSubPanel, [&]{monitorSubPanel.repaint();});
             monitorSubPanel.setMonitorVisible(true);
             repaint();
             if (idx == zlstate::monitorSetting::medium) {
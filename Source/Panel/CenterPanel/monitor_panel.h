@@ -35,7 +35,6 @@ namespace zlpanel {
 
     private:
         MonitorSubPanel monitorSubPanel;
-        std::unique_ptr<juce::VBlankAttachment> vBlankAttachment;
         auto static constexpr largePadding = 1.5f, smallPadding = 0.5f;
         PluginProcessor *processorRef;
         std::atomic<int> monitorSetting = zlstate::monitorSetting::defaultI;
@@ -65,11 +65,11 @@ namespace zlpanel {
         peakStart.push_back(-60);
         peakEnd.push_back(-60);
 
-        startTimerHz(callBackHz);
+        uiBase->getFrameScheduler().addClient(this);
     }
 
     MonitorSubPanel::~MonitorSubPanel() {
-        stopTimer();
+        uiBase->getFrameScheduler().removeClient(this);
     }
 
     void MonitorSubPanel::paint(juce::Graphics &g) {
@@ -150,18 +150,17 @@ namespace zlpanel {
 
     void MonitorSubPanel::setMonitorVisible(bool f) {
         isMonitorVisible.store(f);
-        if (f) {
-            startTimerHz(callBackHz);
-        } else {
-            stopTimer();
-        }
     }
 
     void MonitorSubPanel::setTimeInSecond(float v) {
         timeInSeconds.store(v);
     }
 
-    void MonitorSubPanel::timerCallback() {
+    void MonitorSubPanel::onFrame(zlinterface::FrameScheduler &scheduler, double deltaTime) {
+        juce::ignoreUnused(deltaTime);
+        if (!isMonitorVisible.load()) {
+            return;
+        }
         const juce::GenericScopedLock<juce::CriticalSection> processScopedLock (processLock);
         auto num = meterIn->appendHistoryRMS(rmsIn);
         meterOut->appendHistoryRMS(rmsOut, num);
@@ -170,5 +169,7 @@ namespace zlpanel {
         }
         meterIn->appendHistoryPeak(peakStart, num);
         meterEnd->appendHistoryPeak(peakEnd, num);
+        // the image scrolls with time, so the monitor is redrawn on every frame
+        scheduler.markDirty(*this);
     }
 } // zlpanel
\ No newline at end of file
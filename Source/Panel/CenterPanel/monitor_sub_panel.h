@@ -26,9 +26,9 @@ namespace zlpanel {
                                     size_t xNum, float yMin, float yMax,
                                     float thickness, std::optional<juce::Point<float>> startPoint = std::nullopt);
 
-    class MonitorSubPanel : public juce::Component, private juce::Timer {
+    class MonitorSubPanel : public juce::Component, private zlinterface::FrameScheduler::Client {
     public:
-        auto static constexpr callBackHz = 180, upScaling = 2;
+        auto static constexpr upScaling = 2;
         auto static constexpr dummySize = 20;
 
         explicit MonitorSubPanel(PluginProcessor &p, zlinterface::UIBase &base);
@@ -51,7 +51,7 @@ namespace zlpanel {
         float totalDeltaX = 0.f;
         std::atomic<float> timeInSeconds = 7;
 
-        void timerCallback() override;
+        void onFrame(zlinterface::FrameScheduler &scheduler, double deltaTime) override;
 
         juce::Image image;
         juce::Time previousTime;
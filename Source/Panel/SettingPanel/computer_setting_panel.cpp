@@ -11,17 +11,31 @@
 #include "computer_setting_panel.h"
 
 namespace zlpanel {
-    ComputerSettingPanel::ComputerSettingPanel(juce::AudioProcessorValueTreeState &parameters,
-                                               zlinterface::UIBase &base) {
+    ComputerSettingPanel::ComputerSettingPanel(PluginProcessor &p, zlinterface::UIBase &base) {
         uiBase = &base;
         std::array<std::string, 2> rotarySliderID{zldsp::threshold::ID, zldsp::ratio::ID};
         attachSliders<zlinterface::RotarySliderComponent, 2>(*this, rotarySliderList, sliderAttachments, rotarySliderID,
-                                                             parameters, base);
+                                                             p.parameters, base);
 
-        std::array<std::string, 4> linearSliderID{zldsp::kneeW::ID, zldsp::kneeS::ID, zldsp::kneeD::ID,
-                                                  zldsp::bound::ID};
-        attachSliders<zlinterface::LinearSliderComponent, 4>(*this, linearSliderList, sliderAttachments, linearSliderID,
-                                                             parameters, base);
+        std::array<std::string, 5> linearSliderID{zldsp::kneeW::ID, zldsp::kneeS::ID, zldsp::kneeD::ID,
+                                                  zldsp::bound::ID, zldsp::morph::ID};
+        attachSliders<zlinterface::LinearSliderComponent, 5>(*this, linearSliderList, sliderAttachments, linearSliderID,
+                                                             p.parameters, base);
+
+        std::array<std::string, 1> buttonID{zldsp::morphOn::ID};
+        attachButtons<zlinterface::ButtonComponent, 1>(*this, buttonList, buttonAttachments, buttonID,
+                                                       p.parameters, base);
+
+        // both precisions share the parameters, so storing through one attach is enough
+        auto &computerAttach = p.getComputerAttach();
+        for (size_t slot = 0; slot < storeButtons.size(); ++slot) {
+            storeButtons[slot] = std::make_unique<zlinterface::ButtonComponent>("Store " + juce::String(slot + 1), base);
+            storeButtons[slot]->getButton().setClickingTogglesState(false);
+            storeButtons[slot]->getButton().onClick = [&computerAttach, slot]() {
+                computerAttach.storeMorphSlot(slot);
+            };
+            addAndMakeVisible(*storeButtons[slot]);
+        }
 
         uiBase = &base;
     }
@@ -42,16 +56,22 @@ namespace zlpanel {
         using Track = juce::Grid::TrackInfo;
         using Fr = juce::Grid::Fr;
 
-        grid.templateRows = {Track(Fr(6)), Track(Fr(3)), Track(Fr(3))};
-        grid.templateColumns = {Track(Fr(1)), Track(Fr(1))};
+        grid.templateRows = {Track(Fr(6)), Track(Fr(3)), Track(Fr(3)), Track(Fr(3)), Track(Fr(3))};
+        grid.templateColumns = {Track(Fr(1)), Track(Fr(1)), Track(Fr(1)), Track(Fr(1))};
 
         juce::Array<juce::GridItem> items;
-        items.add(*thresholdSlider);
-        items.add(*ratioSlider);
-        items.add(*kneeWSlider);
-        items.add(*kneeSSlider);
-        items.add(*kneeDSlider);
-        items.add(*boundSlider);
+        items.add(juce::GridItem(*thresholdSlider).withArea(1, 1, 2, 3));
+        items.add(juce::GridItem(*ratioSlider).withArea(1, 3, 2, 5));
+        items.add(juce::GridItem(*kneeWSlider).withArea(2, 1, 3, 3));
+        items.add(juce::GridItem(*kneeSSlider).withArea(2, 3, 3, 5));
+        items.add(juce::GridItem(*kneeDSlider).withArea(3, 1, 4, 3));
+        items.add(juce::GridItem(*boundSlider).withArea(3, 3, 4, 5));
+        items.add(juce::GridItem(*morphOnButton).withArea(4, 1, 5, 2));
+        items.add(juce::GridItem(*morphSlider).withArea(4, 2, 5, 5));
+        for (size_t slot = 0; slot < storeButtons.size(); ++slot) {
+            const auto column = static_cast<int>(slot) + 1;
+            items.add(juce::GridItem(*storeButtons[slot]).withArea(5, column, 6, column + 1));
+        }
         grid.items = items;
 
         grid.performLayout(bound.toNearestInt());
@@ -12,8 +12,10 @@
 #define ZL_COMPUTER_SETTING_PANEL_H
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "../../PluginProcessor.h"
 #include "../../DSP/dsp_definitions.h"
 #include "../../GUI/interface_definitions.h"
+#include "../../GUI/button_component.h"
 #include "../../GUI/linear_slider_component.h"
 #include "../../GUI/rotary_slider_component.h"
 #include "../panel_definitions.h"
@@ -22,7 +24,7 @@ namespace zlpanel {
 
     class ComputerSettingPanel : public juce::Component {
     public:
-        explicit ComputerSettingPanel(juce::AudioProcessorValueTreeState &parameters, zlinterface::UIBase &base);
+        explicit ComputerSettingPanel(PluginProcessor &p, zlinterface::UIBase &base);
 
         ~ComputerSettingPanel() override;
 
@@ -34,11 +36,18 @@ namespace zlpanel {
         std::unique_ptr<zlinterface::RotarySliderComponent> thresholdSlider, ratioSlider;
         std::array<std::unique_ptr<zlinterface::RotarySliderComponent>*, 2> rotarySliderList{&thresholdSlider, &ratioSlider};
 
-        std::unique_ptr<zlinterface::LinearSliderComponent> kneeWSlider, kneeSSlider, kneeDSlider, boundSlider;
-        std::array<std::unique_ptr<zlinterface::LinearSliderComponent>*, 4> linearSliderList{&kneeWSlider, &kneeSSlider, &kneeDSlider, &boundSlider};
+        std::unique_ptr<zlinterface::LinearSliderComponent> kneeWSlider, kneeSSlider, kneeDSlider, boundSlider, morphSlider;
+        std::array<std::unique_ptr<zlinterface::LinearSliderComponent>*, 5> linearSliderList{&kneeWSlider, &kneeSSlider, &kneeDSlider, &boundSlider, &morphSlider};
 
         juce::OwnedArray<juce::AudioProcessorValueTreeState::SliderAttachment> sliderAttachments;
 
+        std::unique_ptr<zlinterface::ButtonComponent> morphOnButton;
+        std::array<std::unique_ptr<zlinterface::ButtonComponent>*, 1> buttonList{&morphOnButton};
+        juce::OwnedArray<juce::AudioProcessorValueTreeState::ButtonAttachment> buttonAttachments;
+
+        // capture the current computer parameters into each morph slot
+        std::array<std::unique_ptr<zlinterface::ButtonComponent>, zldsp::maxMorphSlotNum> storeButtons;
+
         zlinterface::UIBase *uiBase;
     };
 
@@ -11,11 +11,10 @@
 #include "setting_panel.h"
 
 namespace zlpanel {
-    SettingPanel::SettingPanel(juce::AudioProcessorValueTreeState &parameters,
-                               zlinterface::UIBase &base) :
-            globalSettingPanel(parameters, base),
-            computerSettingPanel(parameters, base),
-            detectorSettingPanel(parameters, base) {
+    SettingPanel::SettingPanel(PluginProcessor &p, zlinterface::UIBase &base) :
+            globalSettingPanel(p.parameters, base),
+            computerSettingPanel(p, base),
+            detectorSettingPanel(p.parameters, base) {
         addAndMakeVisible(globalSettingPanel);
         addAndMakeVisible(computerSettingPanel);
         addAndMakeVisible(detectorSettingPanel);
@@ -19,8 +19,7 @@ namespace zlpanel {
 
     class SettingPanel : public juce::Component {
     public:
-        explicit SettingPanel(juce::AudioProcessorValueTreeState &parameters,
-                              zlinterface::UIBase &base);
+        explicit SettingPanel(PluginProcessor &p, zlinterface::UIBase &base);
 
         ~SettingPanel() override;
 
@@ -15,19 +15,22 @@ namespace zlpanel {
             uiBase(),
             statePanel(p, uiBase),
             centerPanel(p, uiBase),
-            settingPanel(p.parameters, uiBase) {
+            settingPanel(p, uiBase) {
 //            meterPanel(&p.getMeterIn(), &p.getMeterEnd()) {
         addAndMakeVisible(centerPanel);
         addAndMakeVisible(settingPanel);
         addAndMakeVisible(statePanel);
 //        addAndMakeVisible(meterPanel);
+        uiBase.getFrameScheduler().attach(*this);
     }
 
     void MainPanel::attachOpenGL(juce::Component &component) {
         centerPanel.attachOpenGL(component);
     }
 
-    MainPanel::~MainPanel() = default;
+    MainPanel::~MainPanel() {
+        uiBase.getFrameScheduler().detach();
+    }
 
     void MainPanel::paint(juce::Graphics &g) {
         g.fillAll(uiBase.getBackgroundColor());
@@ -22,10 +22,8 @@ PluginEditor::PluginEditor(PluginProcessor &p) :
     }
 
     juce::ignoreUnused(processorRef);
-    // set font
-    auto sourceCodePro = juce::Typeface::createSystemTypefaceFor(BinaryData::OpenSansSemiBold_ttf,
-                                                                 BinaryData::OpenSansSemiBold_ttfSize);
-    juce::LookAndFeel::getDefaultLookAndFeel().setDefaultSansSerifTypeface(sourceCodePro);
+    // set font, the typeface is shared by all editors
+    juce::LookAndFeel::getDefaultLookAndFeel().setDefaultSansSerifTypeface(sharedResources->getOpenSansSemiBold());
 
     addAndMakeVisible(mainPanel);
 
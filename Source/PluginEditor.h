@@ -14,6 +14,7 @@
 #include "Panel/main_panel.h"
 #include "State/state_definitions.h"
 #include "State/property.h"
+#include "GUI/shared_resources.h"
 
 //==============================================================================
 class PluginEditor : public juce::AudioProcessorEditor,
@@ -32,6 +33,7 @@ public:
 
 private:
     PluginProcessor &processorRef;
+    juce::SharedResourcePointer<zlinterface::SharedResources> sharedResources;
     zlstate::Property property;
     zlpanel::MainPanel mainPanel;
     juce::Value lastUIWidth, lastUIHeight;
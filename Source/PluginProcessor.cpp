@@ -10,6 +10,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "GUI/shadow_cache.h"
 
 //==============================================================================
 PluginProcessor::PluginProcessor()
@@ -31,15 +32,33 @@ PluginProcessor::PluginProcessor()
                  juce::Identifier("ZLECompStates"),
                  zlstate::getParameterLayout()),
           controller(*this, parameters),
-          controllerAttach(*this, controller, parameters, parametersNA),
-          detectorAttach(controller, parameters),
-          computerAttach(*this, controller, parameters) {
+          controllerAttach(*this, controller, parameters, parametersNA, dispatcher),
+          detectorAttach(controller, parameters, dispatcher),
+          computerAttach(*this, controller, parameters, parametersNA, dispatcher),
+          sideFilterAttach(*this, controller, parameters),
+          doubleController(*this, parameters),
+          doubleControllerAttach(*this, doubleController, parameters, parametersNA, dispatcher),
+          doubleDetectorAttach(doubleController, parameters, dispatcher),
+          doubleComputerAttach(*this, doubleController, parameters, parametersNA, dispatcher),
+          doubleSideFilterAttach(*this, doubleController, parameters),
+          stateCodec({&parameters, &parametersNA}),
+          presetCache(parameters) {
     controllerAttach.initDefaultVs();
     controllerAttach.addListeners();
     detectorAttach.initDefaultVs();
     detectorAttach.addListeners();
     computerAttach.initDefaultVs();
     computerAttach.addListeners();
+    sideFilterAttach.initDefaultVs();
+    sideFilterAttach.addListeners();
+    doubleControllerAttach.initDefaultVs();
+    doubleControllerAttach.addListeners();
+    doubleDetectorAttach.initDefaultVs();
+    doubleDetectorAttach.addListeners();
+    doubleComputerAttach.initDefaultVs();
+    doubleComputerAttach.addListeners();
+    doubleSideFilterAttach.initDefaultVs();
+    doubleSideFilterAttach.addListeners();
 }
 
 PluginProcessor::~PluginProcessor() = default;
@@ -78,7 +97,8 @@ double PluginProcessor::getTailLengthSeconds() const {
 }
 
 int PluginProcessor::getNumPrograms() {
-    return static_cast<int>(zlstate::preset::presetNUM);
+    // user presets follow the factory presets, the shared index scans the directory on first use
+    return static_cast<int>(zlstate::preset::presetNUM + presetCache.getUserPresets().size());
 }
 
 int PluginProcessor::getCurrentProgram() {
@@ -86,19 +106,34 @@ int PluginProcessor::getCurrentProgram() {
 }
 
 void PluginProcessor::setCurrentProgram(int index) {
+    if (index < 0 || index >= getNumPrograms()) {
+        return;
+    }
     programIndex.store(index);
-    parametersNA.getParameter(zlstate::programIdx::ID)->setValueNotifyingHost(zlstate::programIdx::convertTo01(index));
+    // a user preset carries no factory linkage, e.g. the halved RMS size
+    const auto factoryIdx = index < zlstate::preset::presetNUM ? index : static_cast<int>(zlstate::preset::nothing);
+    parametersNA.getParameter(zlstate::programIdx::ID)->setValueNotifyingHost(
+        zlstate::programIdx::convertTo01(factoryIdx));
     if (index < zlstate::preset::presetNUM) {
-        juce::XmlDocument xmlDocument{zlstate::preset::xmls[static_cast<size_t>(index)]};
-        const auto valueTreeToLoad = juce::ValueTree::fromXml(*xmlDocument.getDocumentElement());
-        parameters.replaceState(valueTreeToLoad.getChildWithName("ZLECompParameters"));
+        presetCache.applyFactory(static_cast<size_t>(index));
+    } else if (const auto metadata = presetCache.getUserPresets().get(
+            static_cast<size_t>(index - zlstate::preset::presetNUM))) {
+        presetCache.applyUser(metadata->file);
     }
+    applyPendingChanges();
 }
 
 const juce::String PluginProcessor::getProgramName(int index) {
+    if (index < 0) {
+        return {};
+    }
     if (index < zlstate::preset::presetNUM) {
         return zlstate::preset::names[static_cast<size_t>(index)];
     }
+    if (const auto metadata = presetCache.getUserPresets().get(
+            static_cast<size_t>(index - zlstate::preset::presetNUM))) {
+        return metadata->name;
+    }
     return {};
 }
 
@@ -111,13 +146,25 @@ void PluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
                                                           getMainBusNumOutputChannels()));
     juce::dsp::ProcessSpec spec{sampleRate, static_cast<juce::uint32> (samplesPerBlock),
                                 channels};
-    controller.prepare(spec);
+    // the controller of the other precision only stores parameter changes
+    if (isUsingDoublePrecision()) {
+        controller.release();
+        doubleController.prepare(spec);
+    } else {
+        doubleController.release();
+        controller.prepare(spec);
+    }
 }
 
-void PluginProcessor::releaseResources() {}
+void PluginProcessor::releaseResources() {
+    controller.release();
+    doubleController.release();
+}
 
 bool PluginProcessor::isBusesLayoutSupported(const BusesLayout &layouts) const {
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo()) {
+    // accept any main layout from mono up to 7.1.4
+    const auto mainOutput = layouts.getMainOutputChannelSet();
+    if (mainOutput.isDisabled() || mainOutput.size() > zldsp::maxChannelNum) {
         return false;
     }
     if (layouts.getChannelSet(true, 0) != layouts.getChannelSet(true, 1)) {
@@ -143,6 +190,25 @@ void PluginProcessor::processBlock(juce::AudioBuffer<float> &buffer,
     controller.process(buffer);
 }
 
+void PluginProcessor::processBlock(juce::AudioBuffer<double> &buffer,
+                                   juce::MidiBuffer &midiMessages) {
+    juce::ignoreUnused(midiMessages);
+
+    juce::ScopedNoDenormals noDenormal;
+    auto totalNumInputChannels = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear(i, 0, buffer.getNumSamples());
+
+    doubleController.process(buffer);
+}
+
+juce::AudioProcessorParameter *PluginProcessor::getBypassParameter() const {
+    // let the host use the latency-preserving bypass of the controller
+    return parameters.getParameter(zldsp::byPass::ID);
+}
+
 //==============================================================================
 bool PluginProcessor::hasEditor() const {
     return true; // (change this to false if you choose to not supply an editor)
@@ -154,14 +220,16 @@ juce::AudioProcessorEditor *PluginProcessor::createEditor() {
 
 //==============================================================================
 void PluginProcessor::getStateInformation(juce::MemoryBlock &destData) {
-    auto tempTree = juce::ValueTree("ZLECompParaState");
-    tempTree.appendChild(parameters.copyState(), nullptr);
-    tempTree.appendChild(parametersNA.copyState(), nullptr);
-    std::unique_ptr<juce::XmlElement> xml(tempTree.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateCodec.write(destData);
 }
 
 void PluginProcessor::setStateInformation(const void *data, int sizeInBytes) {
+    if (stateCodec.read(data, sizeInBytes)) {
+        programIndex.store(static_cast<int>(parametersNA.getRawParameterValue(zlstate::programIdx::ID)->load()));
+        applyPendingChanges();
+        return;
+    }
+    // migrate the legacy XML state
     std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
     if (xmlState != nullptr && xmlState->hasTagName("ZLECompParaState")) {
         auto tempTree = juce::ValueTree::fromXml(*xmlState);
@@ -169,6 +237,33 @@ void PluginProcessor::setStateInformation(const void *data, int sizeInBytes) {
         parametersNA.replaceState(tempTree.getChildWithName(parametersNA.state.getType()));
         programIndex.store(static_cast<int>(parametersNA.getRawParameterValue(zlstate::programIdx::ID)->load()));
     }
+    applyPendingChanges();
+}
+
+void PluginProcessor::applyPendingChanges() {
+    // the host may process right after loading a state, without running the message loop in between
+    controller.applyPendingChanges();
+    doubleController.applyPendingChanges();
+}
+
+zlcontroller::Footprint PluginProcessor::getFootprint() {
+    // the value trees and the editor are owned by the message thread
+    JUCE_ASSERT_MESSAGE_THREAD
+    zlcontroller::Footprint footprint;
+    {
+        const juce::GenericScopedLock<juce::CriticalSection> processLock(getCallbackLock());
+        footprint += controller.getFootprint();
+        footprint += doubleController.getFootprint();
+    }
+    // value trees do not report their memory, measure their serialized size instead
+    for (const auto *tree: {&parameters, &parametersNA, &states}) {
+        juce::MemoryOutputStream stream;
+        tree->state.writeToStream(stream);
+        footprint.bytes[zlcontroller::Footprint::parameterTrees] += stream.getDataSize();
+    }
+    // the cache lives as long as the process, whether this instance has an editor or not
+    footprint.sharedEditorImages = zlinterface::ShadowCache::getInstance().getTotalBytes();
+    return footprint;
 }
 
 //==============================================================================
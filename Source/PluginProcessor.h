@@ -14,12 +14,16 @@
 #include <juce_dsp/juce_dsp.h>
 #include <BinaryData.h>
 #include "State/dummy_processor.h"
+#include "State/preset_cache.h"
+#include "State/property.h"
+#include "State/state_codec.h"
 #include "State/state_definitions.h"
 #include "DSP/dsp_definitions.h"
 #include "DSP/controller.h"
 #include "DSP/controller_attach.h"
 #include "DSP/detector_attach.h"
 #include "DSP/computer_attach.h"
+#include "DSP/side_filter_attach.h"
 
 #if (MSVC)
 #include "ipps.h"
@@ -44,6 +48,12 @@ public:
 
     void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
 
+    void processBlock(juce::AudioBuffer<double> &, juce::MidiBuffer &) override;
+
+    bool supportsDoublePrecisionProcessing() const override { return true; }
+
+    juce::AudioProcessorParameter *getBypassParameter() const override;
+
     juce::AudioProcessorEditor *createEditor() override;
 
     bool hasEditor() const override;
@@ -84,23 +94,52 @@ public:
         return computerAttach;
     }
 
+    inline zlstate::PresetCache &getPresetCache() {
+        return presetCache;
+    }
+
     inline zlmeter::MeterSource<float> &getMeterIn() {
-        return controller.meterIn;
+        return isUsingDoublePrecision() ? doubleController.meterIn : controller.meterIn;
     }
 
     inline zlmeter::MeterSource<float> &getMeterOut() {
-        return controller.meterOut;
+        return isUsingDoublePrecision() ? doubleController.meterOut : controller.meterOut;
     }
 
     inline zlmeter::MeterSource<float> &getMeterEnd() {
-        return controller.meterEnd;
+        return isUsingDoublePrecision() ? doubleController.meterEnd : controller.meterEnd;
     }
 
+    /**
+     * bytes held by each subsystem of this instance, the editor images shared by all instances are reported apart
+     */
+    zlcontroller::Footprint getFootprint();
+
 private:
+    // runs the derived work of parameter changes on the message thread, it must outlive the attaches
+    zlcontroller::Dispatcher dispatcher;
     zlcontroller::Controller<float> controller;
     zlcontroller::ControllerAttach<float> controllerAttach;
     zlcontroller::DetectorAttach<float> detectorAttach;
     zlcontroller::ComputerAttach<float> computerAttach;
+    zlcontroller::SideFilterAttach<float> sideFilterAttach;
+    // double precision path, only prepared when the host processes in double
+    zlcontroller::Controller<double> doubleController;
+    zlcontroller::ControllerAttach<double> doubleControllerAttach;
+    zlcontroller::DetectorAttach<double> doubleDetectorAttach;
+    zlcontroller::ComputerAttach<double> doubleComputerAttach;
+    zlcontroller::SideFilterAttach<double> doubleSideFilterAttach;
+    // binary plugin state of parameters and parametersNA
+    zlstate::StateCodec stateCodec;
+    zlstate::PresetCache presetCache;
+    // keeps the UI state writer alive while editors come and go
+    juce::SharedResourcePointer<zlstate::PropertyWriter> propertyWriter;
     std::atomic<int> programIndex = 0;
+
+    /**
+     * apply the settings stored by a state or a program change before the next block
+     */
+    void applyPendingChanges();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,197 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version. ZLEComp is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+
+#include "preset_cache.h"
+
+namespace zlstate {
+    PresetCache::PresetCache(juce::AudioProcessorValueTreeState &apvts) {
+        for (auto *p: apvts.processor.getParameters()) {
+            if (auto *para = dynamic_cast<juce::RangedAudioParameter *>(p)) {
+                if (apvts.getParameter(para->getParameterID()) == para) {
+                    paras.push_back(para);
+                }
+            }
+        }
+    }
+
+    void PresetCache::applyFactory(size_t idx) {
+        if (idx < preset::presetNUM) {
+            apply(getFactoryValues()[idx]);
+        }
+    }
+
+    bool PresetCache::applyUser(const juce::File &file) {
+        if (const auto xml = juce::XmlDocument::parse(file)) {
+            apply(parse(*xml));
+            return true;
+        }
+        return false;
+    }
+
+    const std::array<PresetCache::Values, preset::presetNUM> &PresetCache::getFactoryValues() const {
+        // every instance shares the same parameter layout, so the factory presets are parsed only once
+        static const auto values = [this]() {
+            std::array<Values, preset::presetNUM> v;
+            for (size_t i = 0; i < preset::presetNUM; ++i) {
+                if (const auto xml = juce::XmlDocument::parse(preset::xmls[i])) {
+                    v[i] = parse(*xml);
+                }
+            }
+            return v;
+        }();
+        return values;
+    }
+
+    PresetCache::Values PresetCache::parse(const juce::XmlElement &xml) const {
+        // parameters missing in the preset fall back to their defaults, as replaceState does
+        Values values(paras.size());
+        std::unordered_map<juce::String, size_t> indices;
+        for (size_t i = 0; i < paras.size(); ++i) {
+            values[i] = paras[i]->getDefaultValue();
+            indices[paras[i]->getParameterID()] = i;
+        }
+        const auto *tree = xml.hasTagName("ZLECompParameters") ? &xml : xml.getChildByName("ZLECompParameters");
+        if (tree == nullptr) {
+            return values;
+        }
+        for (auto *child: tree->getChildWithTagNameIterator("PARAM")) {
+            const auto it = indices.find(child->getStringAttribute("id"));
+            if (it != indices.end()) {
+                const auto plain = static_cast<float>(child->getDoubleAttribute("value"));
+                values[it->second] = paras[it->second]->convertTo0to1(plain);
+            }
+        }
+        return values;
+    }
+
+    void PresetCache::apply(const Values &values) {
+        // a single pass over all parameters, the host is only notified about values that change
+        for (size_t i = 0; i < juce::jmin(paras.size(), values.size()); ++i) {
+            if (paras[i]->getValue() != values[i]) {
+                paras[i]->setValueNotifyingHost(values[i]);
+            }
+        }
+    }
+
+    size_t UserPresetIndex::size() {
+        const juce::ScopedLock scopedLock(lock);
+        scanIfNeeded();
+        return presets.size();
+    }
+
+    std::optional<UserPresetIndex::Metadata> UserPresetIndex::get(size_t idx) {
+        const juce::ScopedLock scopedLock(lock);
+        scanIfNeeded();
+        if (idx < presets.size()) {
+            return presets[idx];
+        }
+        return std::nullopt;
+    }
+
+    void UserPresetIndex::rescan() {
+        const juce::ScopedLock scopedLock(lock);
+        const auto wasScanned = isScanned;
+        scanIfNeeded();
+        if (wasScanned) {
+            scan();
+        }
+    }
+
+    void UserPresetIndex::scanIfNeeded() {
+        if (!isScanned) {
+            loadIndex();
+            isScanned = true;
+            scan();
+        }
+    }
+
+    void UserPresetIndex::scan() {
+        std::unordered_map<juce::String, size_t> cached;
+        for (size_t i = 0; i < presets.size(); ++i) {
+            cached[presets[i].file.getFullPathName()] = i;
+        }
+
+        std::vector<Metadata> scanned;
+        bool isChanged = false;
+        for (const auto &entry: juce::RangedDirectoryIterator(userPath, true, "*.xml", juce::File::findFiles)) {
+            const auto &file = entry.getFile();
+            const auto modified = entry.getModificationTime().toMilliseconds();
+            const auto size = entry.getFileSize();
+            const auto it = cached.find(file.getFullPathName());
+            if (it != cached.end() && presets[it->second].modified == modified
+                && presets[it->second].size == size) {
+                scanned.push_back(presets[it->second]);
+                continue;
+            }
+            // only the root attributes are needed, the parameters are parsed when the preset is applied
+            isChanged = true;
+            Metadata metadata{file, file.getFileNameWithoutExtension(),
+                              file.getParentDirectory() == userPath ? juce::String()
+                                                                    : file.getParentDirectory().getFileName(),
+                              modified, size};
+            if (const auto xml = juce::XmlDocument(file).getDocumentElementIfTagMatches("ZLECompParaState")) {
+                metadata.name = xml->getStringAttribute("name", metadata.name);
+                metadata.category = xml->getStringAttribute("category", metadata.category);
+            }
+            scanned.push_back(std::move(metadata));
+        }
+        // removed files show up as a smaller index
+        isChanged = isChanged || scanned.size() != presets.size();
+        presets = std::move(scanned);
+        std::sort(presets.begin(), presets.end(), [](const Metadata &a, const Metadata &b) {
+            return a.category != b.category ? a.category < b.category : a.name < b.name;
+        });
+        if (isChanged) {
+            saveIndex();
+        }
+    }
+
+    void UserPresetIndex::loadIndex() {
+        presets.clear();
+        juce::FileInputStream stream(indexFile);
+        if (!stream.openedOk()) {
+            return;
+        }
+        const auto tree = juce::ValueTree::readFromStream(stream);
+        for (const auto &child: tree) {
+            presets.push_back({userPath.getChildFile(child.getProperty("path").toString()),
+                                   child.getProperty("name").toString(),
+                                   child.getProperty("category").toString(),
+                                   static_cast<juce::int64>(child.getProperty("modified")),
+                                   static_cast<juce::int64>(child.getProperty("size"))});
+        }
+    }
+
+    void UserPresetIndex::saveIndex() const {
+        juce::ValueTree tree("ZLECompPresetIndex");
+        for (const auto &metadata: presets) {
+            juce::ValueTree child("PRESET");
+            child.setProperty("path", metadata.file.getRelativePathFrom(userPath), nullptr);
+            child.setProperty("name", metadata.name, nullptr);
+            child.setProperty("category", metadata.category, nullptr);
+            child.setProperty("modified", metadata.modified, nullptr);
+            child.setProperty("size", metadata.size, nullptr);
+            tree.appendChild(child, nullptr);
+        }
+        juce::TemporaryFile temp(indexFile);
+        if (auto stream = temp.getFile().createOutputStream()) {
+            tree.writeToStream(*stream);
+            stream.reset();
+            temp.overwriteTargetFileWithTemporary();
+        }
+    }
+} // namespace zlstate
@@ -0,0 +1,103 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version. ZLEComp is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+
+#ifndef ZLECOMP_PRESET_CACHE_H
+#define ZLECOMP_PRESET_CACHE_H
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "state_definitions.h"
+
+namespace zlstate {
+
+    /**
+     * the index of user presets on disk, shared by all instances through juce::SharedResourcePointer
+     * the directory is scanned once on first use, a rescan only parses new or modified files
+     * the metadata cache on disk is only written when the index has changed
+     */
+    class UserPresetIndex {
+    public:
+        struct Metadata {
+            juce::File file;
+            juce::String name, category;
+            juce::int64 modified = 0, size = 0;
+        };
+
+        size_t size();
+
+        std::optional<Metadata> get(size_t idx);
+
+        /**
+         * refresh the index, e.g. after a preset has been saved or removed
+         */
+        void rescan();
+
+        inline auto static const userPath =
+                juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                        .getChildFile("Audio")
+                        .getChildFile("Presets")
+                        .getChildFile(JucePlugin_Manufacturer)
+                        .getChildFile(JucePlugin_Name)
+                        .getChildFile("User");
+
+    private:
+        // instances may ask for programs from different threads
+        juce::CriticalSection lock;
+        std::vector<Metadata> presets;
+        bool isScanned = false;
+
+        inline auto static const indexFile = userPath.getChildFile(".index");
+
+        void scanIfNeeded();
+
+        void scan();
+
+        void loadIndex();
+
+        void saveIndex() const;
+    };
+
+    /**
+     * factory presets are parsed once per process into vectors of normalized parameter values
+     * user presets are listed by the shared UserPresetIndex, their parameters are parsed when applied
+     */
+    class PresetCache {
+    public:
+        explicit PresetCache(juce::AudioProcessorValueTreeState &apvts);
+
+        void applyFactory(size_t idx);
+
+        bool applyUser(const juce::File &file);
+
+        inline UserPresetIndex &getUserPresets() { return *userIndex; }
+
+    private:
+        // normalized value of each parameter, in the order of paras
+        using Values = std::vector<float>;
+
+        std::vector<juce::RangedAudioParameter *> paras;
+        juce::SharedResourcePointer<UserPresetIndex> userIndex;
+
+        const std::array<Values, preset::presetNUM> &getFactoryValues() const;
+
+        Values parse(const juce::XmlElement &xml) const;
+
+        void apply(const Values &values);
+    };
+
+} // namespace zlstate
+
+#endif // ZLECOMP_PRESET_CACHE_H
@@ -18,6 +18,73 @@
 
 namespace zlstate {
 
+    PropertyWriter::PropertyWriter() : juce::Thread("ZLEComp Property Writer") {
+        startThread();
+    }
+
+    PropertyWriter::~PropertyWriter() {
+        // the writer flushes pending states before it exits
+        signalThreadShouldExit();
+        toWrite.signal();
+        stopThread(-1);
+    }
+
+    void PropertyWriter::post(const juce::File &file, juce::String xml) {
+        {
+            const juce::ScopedLock lock(pendingLock);
+            pendingFile = file;
+            pendingXml = std::move(xml);
+            hasPending = true;
+        }
+        toWrite.signal();
+    }
+
+    void PropertyWriter::run() {
+        while (!threadShouldExit()) {
+            toWrite.wait(-1);
+            // coalesce rapid changes
+            while (!threadShouldExit() && toWrite.wait(coalesceMs)) {}
+            writePending();
+        }
+        writePending();
+    }
+
+    std::optional<juce::String> PropertyWriter::getPending(const juce::File &file) {
+        const juce::ScopedLock lock(pendingLock);
+        if (hasPending && pendingFile == file) {
+            return pendingXml;
+        }
+        if (isWriting && writingFile == file) {
+            return writingXml;
+        }
+        return std::nullopt;
+    }
+
+    void PropertyWriter::writePending() {
+        juce::File file;
+        juce::String text;
+        {
+            const juce::ScopedLock lock(pendingLock);
+            if (!hasPending) {
+                return;
+            }
+            writingFile = pendingFile;
+            writingXml = std::move(pendingXml);
+            hasPending = false;
+            isWriting = true;
+            file = writingFile;
+            text = writingXml;
+        }
+        // write to a temporary file and then rename it, so a partially written file is never seen
+        juce::TemporaryFile tempFile(file);
+        if (tempFile.getFile().replaceWithText(text)) {
+            tempFile.overwriteTargetFileWithTemporary();
+        }
+        const juce::ScopedLock lock(pendingLock);
+        isWriting = false;
+        writingXml = {};
+    }
+
     Property::Property() {
         if (!path.isDirectory()) {
             path.createDirectory();
@@ -36,18 +103,17 @@ namespace zlstate {
     }
 
     void Property::loadAPVTS(juce::AudioProcessorValueTreeState &apvts) {
-        const juce::ScopedReadLock myScopedLock(readWriteLock);
-        auto file = uiFile->getFile();
-        if (auto xml = juce::XmlDocument::parse(file)) {
+        // states which have not reached the disk yet are newer than the file
+        const auto file = uiFile->getFile();
+        const auto pending = writer->getPending(file);
+        if (auto xml = pending.has_value() ? juce::XmlDocument::parse(*pending) : juce::XmlDocument::parse(file)) {
             apvts.replaceState(juce::ValueTree::fromXml(*xml));
         }
     }
 
     void Property::saveAPVTS(juce::AudioProcessorValueTreeState &apvts) {
-        const juce::ScopedWriteLock myScopedLock(readWriteLock);
-        auto file = uiFile->getFile();
         if (auto xml = apvts.copyState().createXml()) {
-            xml->writeTo(file);
+            writer->post(uiFile->getFile(), xml->toString());
         }
     }
 } // namespace zlstate
\ No newline at end of file
@@ -22,6 +22,50 @@
 
 namespace zlstate {
 
+    /**
+     * a process-wide writer of the UI states, hold it through juce::SharedResourcePointer
+     * processors hold it as well, so that it outlives the editors and closing an editor never waits for the disk
+     * rapid saves are coalesced, and the file is replaced atomically through a temporary file on the writer thread
+     */
+    class PropertyWriter : private juce::Thread {
+    public:
+        PropertyWriter();
+
+        /**
+         * let the writer flush the pending states and wait until it exits, the thread is never killed
+         */
+        ~PropertyWriter() override;
+
+        /**
+         * hand the serialized states to the writer, it does not touch the disk
+         */
+        void post(const juce::File &file, juce::String xml);
+
+        /**
+         * the states posted for the file which have not reached the disk yet, if any
+         */
+        std::optional<juce::String> getPending(const juce::File &file);
+
+    private:
+        // the latest serialized states which wait to be written, and the states being written
+        // the lock is never held while the disk is accessed
+        juce::CriticalSection pendingLock;
+        juce::File pendingFile, writingFile;
+        juce::String pendingXml, writingXml;
+        bool hasPending = false, isWriting = false;
+        juce::WaitableEvent toWrite;
+        // wait until no new save request arrives for this long
+        inline auto static constexpr coalesceMs = 200;
+
+        void run() override;
+
+        void writePending();
+    };
+
+    /**
+     * load/save the UI states
+     * saving only serializes the states on the calling thread, the file is written by the shared PropertyWriter
+     */
     class Property {
     public:
         Property();
@@ -33,8 +77,8 @@ namespace zlstate {
         void saveAPVTS(juce::AudioProcessorValueTreeState &apvts);
 
     private:
+        juce::SharedResourcePointer<PropertyWriter> writer;
         std::unique_ptr<juce::PropertiesFile> uiFile;
-        juce::ReadWriteLock readWriteLock;
 
         inline auto static const path =
                 juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
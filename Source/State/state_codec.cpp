@@ -0,0 +1,130 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version. ZLEComp is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+
+#include "state_codec.h"
+
+namespace zlstate {
+    StateCodec::StateCodec(std::initializer_list<juce::AudioProcessorValueTreeState *> trees) {
+        for (auto *tree: trees) {
+            std::vector<Slot> table;
+            for (auto *p: tree->processor.getParameters()) {
+                if (auto *para = dynamic_cast<juce::RangedAudioParameter *>(p)) {
+                    if (tree->getParameter(para->getParameterID()) == para) {
+                        table.push_back({hashID(para->getParameterID()), para});
+                    }
+                }
+            }
+            std::sort(table.begin(), table.end(),
+                      [](const Slot &a, const Slot &b) { return a.hash < b.hash; });
+            // IDs must not collide, otherwise the format needs a new version
+            for (size_t i = 1; i < table.size(); ++i) {
+                jassert(table[i - 1].hash != table[i].hash);
+            }
+            tables.push_back(std::move(table));
+        }
+    }
+
+    void StateCodec::write(juce::MemoryBlock &destData) const {
+        size_t totalSize = headerSize;
+        for (auto &table: tables) {
+            totalSize += 4 + table.size() * recordSize;
+        }
+        destData.setSize(totalSize, false);
+        auto *dest = static_cast<char *>(destData.getData());
+
+        juce::ByteOrder::littleEndian32Bit(dest, magic);
+        juce::ByteOrder::littleEndian16Bit(dest + 4, version);
+        juce::ByteOrder::littleEndian16Bit(dest + 6, static_cast<juce::uint16>(tables.size()));
+        dest += headerSize;
+        for (auto &table: tables) {
+            juce::ByteOrder::littleEndian32Bit(dest, static_cast<juce::uint32>(table.size()));
+            dest += 4;
+            for (auto &slot: table) {
+                const auto value = slot.para->convertFrom0to1(slot.para->getValue());
+                juce::uint32 bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                juce::ByteOrder::littleEndian32Bit(dest, slot.hash);
+                juce::ByteOrder::littleEndian32Bit(dest + 4, bits);
+                dest += recordSize;
+            }
+        }
+    }
+
+    bool StateCodec::read(const void *data, int sizeInBytes) const {
+        if (!isBinary(data, sizeInBytes)) {
+            return false;
+        }
+        const auto *src = static_cast<const juce::uint8 *>(data);
+        const auto *end = src + sizeInBytes;
+        const auto blobVersion = juce::ByteOrder::littleEndianShort(src + 4);
+        if (blobVersion > version) {
+            // written by a newer version with an unknown layout, keep the current state
+            jassertfalse;
+            return true;
+        }
+        const auto numTrees = static_cast<size_t>(juce::ByteOrder::littleEndianShort(src + 6));
+        src += headerSize;
+
+        for (size_t t = 0; t < tables.size(); ++t) {
+            auto &table = tables[t];
+            std::vector<bool> found(table.size(), false);
+            if (t < numTrees && end - src >= 4) {
+                const auto numRecords = static_cast<size_t>(juce::ByteOrder::littleEndianInt(src));
+                src += 4;
+                const auto available = static_cast<size_t>(end - src) / recordSize;
+                for (size_t r = 0; r < juce::jmin(numRecords, available); ++r) {
+                    const auto hash = juce::ByteOrder::littleEndianInt(src);
+                    const auto bits = juce::ByteOrder::littleEndianInt(src + 4);
+                    float value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    src += recordSize;
+                    // records are written in hash order, but do not rely on it
+                    const auto it = std::lower_bound(table.begin(), table.end(), hash,
+                                                     [](const Slot &s, juce::uint32 h) { return s.hash < h; });
+                    if (it != table.end() && it->hash == hash) {
+                        it->para->setValueNotifyingHost(it->para->convertTo0to1(value));
+                        found[static_cast<size_t>(it - table.begin())] = true;
+                    }
+                }
+                if (numRecords > available) {
+                    // truncated blob, the remaining trees fall back to defaults
+                    src = end;
+                }
+            }
+            for (size_t i = 0; i < table.size(); ++i) {
+                if (!found[i]) {
+                    table[i].para->setValueNotifyingHost(table[i].para->getDefaultValue());
+                }
+            }
+        }
+        return true;
+    }
+
+    bool StateCodec::isBinary(const void *data, int sizeInBytes) {
+        return data != nullptr && sizeInBytes >= headerSize
+               && juce::ByteOrder::littleEndianInt(data) == magic;
+    }
+
+    juce::uint32 StateCodec::hashID(const juce::String &ID) {
+        auto hash = static_cast<juce::uint32>(2166136261u);
+        for (auto *c = ID.toRawUTF8(); *c != 0; ++c) {
+            hash ^= static_cast<juce::uint8>(*c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+} // namespace zlstate
@@ -0,0 +1,69 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version. ZLEComp is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+// FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License along with
+// ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+
+#ifndef ZLECOMP_STATE_CODEC_H
+#define ZLECOMP_STATE_CODEC_H
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+namespace zlstate {
+
+    /**
+     * a compact binary format of the plugin state
+     * header: magic (uint32), version (uint16), number of trees (uint16)
+     * each tree: number of records (uint32), then records of (ID hash (uint32), plain value (float32))
+     * all fields are little-endian, records are matched by the hash of the parameter ID
+     */
+    class StateCodec {
+    public:
+        inline auto static constexpr magic = static_cast<juce::uint32>(0x43454c5a); // "ZLEC"
+        inline auto static constexpr version = static_cast<juce::uint16>(1);
+
+        explicit StateCodec(std::initializer_list<juce::AudioProcessorValueTreeState *> trees);
+
+        void write(juce::MemoryBlock &destData) const;
+
+        /**
+         * load the state from a binary blob
+         * parameters without a record are set to their default values (as replaceState does)
+         * @return false if the data is not in the binary format, e.g. a legacy XML blob
+         */
+        bool read(const void *data, int sizeInBytes) const;
+
+        static bool isBinary(const void *data, int sizeInBytes);
+
+        /**
+         * 32-bit FNV-1a hash of the parameter ID, stable across builds and platforms
+         */
+        static juce::uint32 hashID(const juce::String &ID);
+
+    private:
+        struct Slot {
+            juce::uint32 hash;
+            juce::RangedAudioParameter *para;
+        };
+
+        // parameters of each tree, sorted by the ID hash
+        std::vector<std::vector<Slot>> tables;
+
+        inline auto static constexpr headerSize = 8;
+        inline auto static constexpr recordSize = 8;
+    };
+
+} // namespace zlstate
+
+#endif // ZLECOMP_STATE_CODEC_H
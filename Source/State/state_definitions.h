@@ -14,6 +14,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include <BinaryData.h>
+#include "../DSP/dsp_definitions.h"
 
 namespace zlstate {
     class preset {
@@ -164,6 +165,7 @@ namespace zlstate {
     inline juce::AudioProcessorValueTreeState::ParameterLayout getNAParameterLayout() {
         juce::AudioProcessorValueTreeState::ParameterLayout layout;
         layout.add(programIdx::get(false));
+        zldsp::morphSlot::addToLayout(layout);
         return layout;
     }
 
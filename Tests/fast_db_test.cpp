@@ -0,0 +1,72 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "DSP/FastMath/fast_db.h"
+
+/**
+ * sweep the fast dB conversions against the standard library and check the bounds stated in fast_db.h
+ */
+namespace {
+    // the sweep covers the dB range the segment loop sees
+    constexpr double minDB = -100, maxDB = 60;
+    constexpr size_t stepNum = 1 << 20;
+
+    template<typename FloatType>
+    bool sweep(const char *name, double dBBound) {
+        std::vector<FloatType> gains(stepNum), dBs(stepNum);
+        for (size_t i = 0; i < stepNum; ++i) {
+            dBs[i] = static_cast<FloatType>(minDB + (maxDB - minDB) * static_cast<double>(i) / (stepNum - 1));
+            gains[i] = static_cast<FloatType>(std::pow(10.0L, static_cast<long double>(dBs[i]) / 20));
+        }
+        auto fastDBs = gains;
+        auto fastGains = dBs;
+        zlmath::gainToDecibels(fastDBs.data(), stepNum, FloatType(-200));
+        zlmath::decibelsToGain(fastGains.data(), stepNum, FloatType(-200));
+
+        double maxDBError = 0, maxGainError = 0;
+        for (size_t i = 0; i < stepNum; ++i) {
+            const auto refDB = 20 * std::log10(static_cast<long double>(gains[i]));
+            const auto refGain = std::pow(10.0L, static_cast<long double>(dBs[i]) / 20);
+            maxDBError = std::max(maxDBError, static_cast<double>(std::abs(fastDBs[i] - refDB)));
+            maxGainError = std::max(maxGainError, static_cast<double>(std::abs(fastGains[i] / refGain - 1)));
+        }
+        // a dB error of e is a relative gain error of about e * ln(10) / 20
+        const auto gainBound = dBBound * std::log(10.0) / 20;
+        const auto isOK = maxDBError <= dBBound && maxGainError <= gainBound;
+        std::printf("%-6s gainToDecibels max error %.3g dB (bound %.3g), decibelsToGain max relative error %.3g "
+                    "(bound %.3g): %s\n", name, maxDBError, dBBound, maxGainError, gainBound, isOK ? "ok" : "FAILED");
+        return isOK;
+    }
+
+    template<typename FloatType>
+    bool checkEdges(const char *name) {
+        // values at and beyond the floor of minusInfinityDb, and inputs outside the range of exp2
+        const auto isOK = zlmath::gainToDecibels(FloatType(0)) == FloatType(-100)
+                          && zlmath::gainToDecibels(FloatType(-1)) == FloatType(-100)
+                          && zlmath::gainToDecibels(FloatType(1e-6)) == FloatType(-100)
+                          && zlmath::decibelsToGain(FloatType(-100)) == FloatType(0)
+                          && zlmath::decibelsToGain(FloatType(-1000)) == FloatType(0)
+                          && zlmath::exp2(FloatType(-5000)) == FloatType(0)
+                          && std::isfinite(zlmath::exp2(FloatType(5000)));
+        std::printf("%-6s edge cases: %s\n", name, isOK ? "ok" : "FAILED");
+        return isOK;
+    }
+}
+
+int main() {
+    auto isOK = sweep<float>("float", 2e-5);
+    isOK = sweep<double>("double", 1e-12) && isOK;
+    isOK = checkEdges<float>("float") && isOK;
+    isOK = checkEdges<double>("double") && isOK;
+    return isOK ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include <cstdio>
+#include "PluginProcessor.h"
+
+/**
+ * prepare a processor without an editor, print its memory footprint and check the report
+ */
+namespace {
+    using Footprint = zlcontroller::Footprint;
+
+    void print(const Footprint &footprint) {
+        for (size_t i = 0; i < Footprint::subsystemNUM; ++i) {
+            std::printf("  %-16s %10zu\n", Footprint::names[i], footprint.bytes[i]);
+        }
+        std::printf("  %-16s %10zu\n", "Total", footprint.getTotal());
+        std::printf("  %-16s %10zu (shared)\n", "Editor Images", footprint.sharedEditorImages);
+    }
+
+    bool expect(bool f, const char *what) {
+        if (!f) {
+            std::printf("FAILED: %s\n", what);
+        }
+        return f;
+    }
+}
+
+int main() {
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    PluginProcessor processor;
+    constexpr double sampleRate = 48000;
+    constexpr int blockSize = 512;
+    const auto numChannels = static_cast<size_t>(processor.getMainBusNumOutputChannels());
+
+    processor.prepareToPlay(sampleRate, blockSize);
+    const auto footprint = processor.getFootprint();
+    std::printf("prepared at %g Hz, %d samples, %zu channels\n", sampleRate, blockSize, numChannels);
+    print(footprint);
+
+    bool isOK = true;
+    for (size_t i = 0; i < Footprint::subsystemNUM; ++i) {
+        isOK = expect(footprint.bytes[i] > 0, Footprint::names[i]) && isOK;
+    }
+    size_t sum = 0;
+    for (const auto b: footprint.bytes) { sum += b; }
+    isOK = expect(footprint.getTotal() == sum, "the total is the sum of all subsystems") && isOK;
+    // the delay line covers the longest segment, main and side block buffers cover a block
+    const auto minDelayBytes = static_cast<size_t>(sampleRate * zldsp::segment::formatV(zldsp::segment::range.end))
+                               * numChannels * sizeof(float);
+    isOK = expect(footprint.bytes[Footprint::delayLines] >= minDelayBytes, "the delay line covers a segment") && isOK;
+    const auto minBlockBytes = static_cast<size_t>(blockSize) * numChannels * 4 * sizeof(float);
+    isOK = expect(footprint.bytes[Footprint::blockBuffers] >= minBlockBytes, "block buffers cover a block") && isOK;
+    isOK = expect(footprint.sharedEditorImages == 0, "no editor images without an editor") && isOK;
+
+    // a larger block grows the block buffers, a smaller one keeps them
+    processor.prepareToPlay(sampleRate, blockSize * 4);
+    const auto larger = processor.getFootprint();
+    processor.prepareToPlay(sampleRate, blockSize);
+    const auto smaller = processor.getFootprint();
+    std::printf("block buffers at %d/%d/%d samples: %zu/%zu/%zu\n", blockSize, blockSize * 4, blockSize,
+                footprint.bytes[Footprint::blockBuffers], larger.bytes[Footprint::blockBuffers],
+                smaller.bytes[Footprint::blockBuffers]);
+    isOK = expect(larger.bytes[Footprint::blockBuffers] > footprint.bytes[Footprint::blockBuffers],
+                  "block buffers grow with the block size") && isOK;
+    isOK = expect(smaller.bytes[Footprint::blockBuffers] == larger.bytes[Footprint::blockBuffers],
+                  "block buffers do not shrink") && isOK;
+
+    processor.releaseResources();
+    std::printf("%s\n", isOK ? "ok" : "FAILED");
+    return isOK ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include <cstdio>
+#include "PluginProcessor.h"
+
+/**
+ * print the member offsets of the classes shared between the message thread and the audio thread
+ * and check that their parameters and states never share a cache line
+ */
+namespace {
+    bool check(const char *name, const zldsp::Layout &layout) {
+        constexpr auto line = zldsp::cacheLineSize;
+        const auto isOK = layout.parameterBegin % line == 0
+                          && layout.stateBegin % line == 0
+                          && layout.parameterEnd <= layout.stateBegin
+                          && layout.size % line == 0;
+        std::printf("%-18s parameters [%zu, %zu) lines %zu-%zu, states from %zu line %zu, size %zu: %s\n",
+                    name, layout.parameterBegin, layout.parameterEnd,
+                    layout.parameterBegin / line, (layout.parameterEnd - 1) / line,
+                    layout.stateBegin, layout.stateBegin / line, layout.size, isOK ? "ok" : "FAILED");
+        return isOK;
+    }
+}
+
+int main() {
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    PluginProcessor processor;
+
+    auto isOK = check("Detector<float>", zldetector::Detector<float>().getLayout());
+    isOK = check("Detector<double>", zldetector::Detector<double>().getLayout()) && isOK;
+    isOK = check("Computer<float>", zlcomputer::Computer<float>().getLayout()) && isOK;
+    isOK = check("Computer<double>", zlcomputer::Computer<double>().getLayout()) && isOK;
+    isOK = check("Controller<float>",
+                 std::make_unique<zlcontroller::Controller<float>>(processor, processor.parameters)->getLayout())
+           && isOK;
+    isOK = check("Controller<double>",
+                 std::make_unique<zlcontroller::Controller<double>>(processor, processor.parameters)->getLayout())
+           && isOK;
+    return isOK ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include <cstdio>
+#include "PluginProcessor.h"
+
+/**
+ * run two bands with different thresholds, a tone in the low band and a tone in the high band
+ * must be compressed by different gains
+ */
+namespace {
+    constexpr double sampleRate = 48000;
+    constexpr int blockSize = 512;
+    constexpr int blockNum = 200;
+
+    void setValue(juce::AudioProcessorValueTreeState &parameters, const juce::String &ID, float v) {
+        auto *para = parameters.getParameter(ID);
+        para->setValueNotifyingHost(para->convertTo0to1(v));
+    }
+
+    // the gain in dB of the last quarter of the output, after the detectors have settled
+    float measureGain(double freq) {
+        PluginProcessor processor;
+        processor.prepareToPlay(sampleRate, blockSize);
+        auto &parameters = processor.parameters;
+        using bp = zldsp::bandParameters;
+        setValue(parameters, zldsp::bandNum::ID, static_cast<float>(zldsp::bandNum::b2));
+        setValue(parameters, zldsp::crossover1::ID, 1000.f);
+        // the first band follows the global parameters, the second band its own
+        setValue(parameters, zldsp::threshold::ID, -40.f);
+        setValue(parameters, zldsp::ratio::ID, 10.f);
+        setValue(parameters, bp::getID(1, bp::thresholdIdx), 0.f);
+        setValue(parameters, bp::getID(1, bp::ratioIdx), 10.f);
+
+        juce::AudioBuffer<float> buffer(processor.getTotalNumInputChannels(), blockSize);
+        juce::MidiBuffer midi;
+        double inSquares = 0, outSquares = 0;
+        juce::int64 pos = 0;
+        for (int block = 0; block < blockNum; ++block) {
+            buffer.clear();
+            std::array<float, blockSize> input{};
+            for (int n = 0; n < blockSize; ++n, ++pos) {
+                input[static_cast<size_t>(n)] = static_cast<float>(
+                        0.5 * std::sin(juce::MathConstants<double>::twoPi * freq * static_cast<double>(pos) / sampleRate));
+            }
+            for (int ch = 0; ch < processor.getMainBusNumInputChannels(); ++ch) {
+                buffer.copyFrom(ch, 0, input.data(), blockSize);
+            }
+            processor.processBlock(buffer, midi);
+            if (block >= blockNum * 3 / 4) {
+                for (const auto x: input) {
+                    inSquares += static_cast<double>(x) * x;
+                }
+                for (int n = 0; n < blockSize; ++n) {
+                    outSquares += static_cast<double>(buffer.getSample(0, n)) * buffer.getSample(0, n);
+                }
+            }
+        }
+        processor.releaseResources();
+        return static_cast<float>(10 * std::log10(outSquares / inSquares));
+    }
+}
+
+int main() {
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const auto lowGain = measureGain(100);
+    const auto highGain = measureGain(5000);
+    // the low band is pushed far above its threshold, the high band stays below it
+    const auto isOK = lowGain < -10.f && highGain > -1.f;
+    std::printf("gain of the low band %.2f dB, gain of the high band %.2f dB: %s\n",
+                lowGain, highGain, isOK ? "ok" : "FAILED");
+    return isOK ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// ==============================================================================
+// Copyright (C) 2023 - zsliu98
+// This file is part of ZLEComp
+//
+// ZLEComp is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+// ZLEComp is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with ZLEComp. If not, see <https://www.gnu.org/licenses/>.
+// ==============================================================================
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "DSP/Kernel/simd_kernels.h"
+
+/**
+ * run every kernel at every level over lengths 0 to 4096 and check that all levels are bit-identical to generic
+ * levels the CPU does not support are clamped by forceLevel, they are reported and compare trivially
+ */
+namespace {
+    constexpr size_t maxLength = 4096;
+    // the inputs start at a few different offsets, so that unaligned heads and tails are covered
+    constexpr size_t maxOffset = 3;
+
+    constexpr std::array levelNames{"generic", "avx2", "avx512"};
+
+    template<typename T>
+    bool isSame(const std::vector<T> &a, const std::vector<T> &b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+    }
+
+    template<typename FloatType>
+    struct Results {
+        std::vector<double> sums;
+        std::vector<FloatType> accSums, maxima, ramped, multiplied;
+    };
+
+    template<typename FloatType>
+    Results<FloatType> run(const std::vector<FloatType> &x, const std::vector<FloatType> &ramp) {
+        Results<FloatType> r;
+        std::vector<FloatType> y;
+        for (size_t num = 0; num <= maxLength; ++num) {
+            const auto offset = num % maxOffset;
+            const auto *input = x.data() + offset;
+            r.sums.push_back(zlkernel::sumOfSquares<double>(input, num));
+            r.accSums.push_back(zlkernel::sumOfSquares<FloatType>(input, num));
+            r.maxima.push_back(zlkernel::maximum(input, num));
+
+            y.assign(input, input + num);
+            zlkernel::multiplyRamp(y.data(), ramp.data() + offset, FloatType(0.25), FloatType(0.5), num);
+            r.ramped.insert(r.ramped.end(), y.begin(), y.end());
+
+            y.assign(input, input + num);
+            zlkernel::multiply(y.data(), FloatType(0.7071), num);
+            r.multiplied.insert(r.multiplied.end(), y.begin(), y.end());
+        }
+        return r;
+    }
+
+    template<typename FloatType>
+    bool check(const char *name) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<FloatType> dist(FloatType(-1), FloatType(1));
+        std::vector<FloatType> x(maxLength + maxOffset), ramp(maxLength + maxOffset);
+        for (auto &v: x) { v = dist(gen); }
+        for (size_t i = 0; i < ramp.size(); ++i) {
+            ramp[i] = static_cast<FloatType>(i) / static_cast<FloatType>(ramp.size());
+        }
+
+        zlkernel::forceLevel(zlkernel::generic);
+        const auto reference = run(x, ramp);
+        bool isOK = true;
+        for (size_t level = zlkernel::generic + 1; level < zlkernel::levelNUM; ++level) {
+            zlkernel::forceLevel(static_cast<zlkernel::Level>(level));
+            if (zlkernel::getLevel() != level) {
+                std::printf("%-6s %-7s not supported, runs as %s\n", name, levelNames[level],
+                            levelNames[zlkernel::getLevel()]);
+            }
+            const auto results = run(x, ramp);
+            const auto isLevelOK = isSame(results.sums, reference.sums)
+                                   && isSame(results.accSums, reference.accSums)
+                                   && isSame(results.maxima, reference.maxima)
+                                   && isSame(results.ramped, reference.ramped)
+                                   && isSame(results.multiplied, reference.multiplied);
+            std::printf("%-6s %-7s bit-identical to generic: %s\n", name, levelNames[level],
+                        isLevelOK ? "ok" : "FAILED");
+            isOK = isOK && isLevelOK;
+        }
+        zlkernel::forceLevel(zlkernel::getSupportedLevel());
+        return isOK;
+    }
+}
+
+int main() {
+    auto isOK = check<float>("float");
+    isOK = check<double>("double") && isOK;
+    return isOK ? 0 : 1;
+}